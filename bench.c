@@ -0,0 +1,278 @@
+/* Copyright (C) 2001-2001 Fujitsu Siemens Computers
+   Joachim Braeuer
+   This file is part of smbios
+
+   smbios is free software; you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License,
+   or (at your option) any later version.
+
+   smbios is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+   for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with smbios; see the file COPYING. If not, write to the
+   Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+   Boston, MA 02111-1307, USA.
+*/
+
+/** \file bench.c
+ *  benchmarks for the table access functions
+ *  The functions defined in this file are only built with DEBUG=y. They
+ *  run once while the module is loaded and report their results with
+ *  PDEBUG.
+ */
+
+#ifndef __KERNEL__
+#  define __KERNEL__
+#endif
+#ifndef MODULE
+#  define MODULE
+#endif
+
+#define __NO_VERSION__		/* don't define kernel_verion in module.h */
+#include <linux/module.h>
+
+#ifdef _DEBUG_
+
+#include <linux/kernel.h>	/* ... for 'printk()' */
+#include <linux/types.h>	/* ... fixed size types definitions, '__u8'... */
+#include <linux/proc_fs.h>	/* ... for 'struct proc_dir_entry' */
+#include <linux/string.h>	/* ... for 'memcpy()' */
+#include <asm/io.h>		    /* ... for 'memcpy_fromio()' */
+#include <linux/vmalloc.h>	/* ... for 'vmalloc()' */
+#include <asm/timex.h>		/* ... for 'get_cycles()' */
+#include <asm/div64.h>		/* ... for 'do_div()' */
+
+#include "bios.h"		    /* ... local declarations for DMI-, SM-BIOS */
+
+
+/** number of times every structure is read by the benchmarks */
+#define BENCH_ROUNDS        100
+
+
+/** \fn void smbios_bench_reads (void *mapped, void *snapshot, unsigned int length)
+ *  \brief compares reading the structures from the mapped table and from its copy
+ *  \param mapped the ioremap()ed structure table
+ *  \param snapshot the copy of the structure table in kernel memory
+ *  \param length length of the structure table
+ *
+ *  Every structure is copied BENCH_ROUNDS times into a scratch buffer,
+ *  once from each source, just like a raw file is read. The average number
+ *  of cycles per read is reported for both sources.
+ */
+
+void
+smbios_bench_reads (void *mapped, void *snapshot, unsigned int length)
+{
+    unsigned char *scratch;
+    unsigned int offset;
+    unsigned int struct_length;
+    unsigned int reads = 0;
+    unsigned int round;
+    cycles_t start;
+    cycles_t mapped_cycles = 0;
+    cycles_t snapshot_cycles = 0;
+    __u64 mapped_average;
+    __u64 snapshot_average;
+
+
+    if (!(scratch = kmalloc (length ? length : 1, GFP_KERNEL)))
+        return;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (offset = 0; offset + sizeof (smbios_struct) <= length; offset += struct_length)
+        {
+            if (!(struct_length = smbios_get_struct_length ((smbios_struct *) ((unsigned char *) snapshot + offset),
+                                                            length - offset)))
+                break;
+
+            start = get_cycles ();
+            memcpy_fromio (scratch, (unsigned char *) mapped + offset, struct_length);
+            mapped_cycles += get_cycles () - start;
+
+            start = get_cycles ();
+            memcpy (scratch, (unsigned char *) snapshot + offset, struct_length);
+            snapshot_cycles += get_cycles () - start;
+
+            reads++;
+        }
+    }
+
+    kfree (scratch);
+
+    if (!reads)
+        return;
+
+    /* a 64 bit division needs do_div(), the kernel has no __udivdi3() */
+    mapped_average = mapped_cycles;
+    do_div (mapped_average, reads);
+    snapshot_average = snapshot_cycles;
+    do_div (snapshot_average, reads);
+
+    PDEBUG ("bench: %u reads, %lu cycles per read from the mapped table, %lu from the copy\n",
+            reads, (unsigned long) mapped_average, (unsigned long) snapshot_average);
+}
+
+
+
+/** \fn void smbios_bench_scan (void)
+ *  \brief measures the time needed to scan the F-segment for the entry points
+ *
+ *  smbios_scan_anchors() is run BENCH_ROUNDS times on a synthetic 64 KB
+ *  segment without any entry point, which is the worst case since every
+ *  paragraph is looked at. The segment is filled with pseudo random bytes,
+ *  every 8th of them an '_', so the byte wise DMI-BIOS check is exercised.
+ */
+
+void
+smbios_bench_scan (void)
+{
+    unsigned char *segment;
+    smbios_anchors anchors;
+    unsigned int seed = 1;
+    unsigned int i;
+    cycles_t start;
+    cycles_t cycles;
+    __u64 average;
+
+
+    if (!(segment = vmalloc (BIOS_MAP_LENGTH)))
+        return;
+
+    for (i = 0; i < BIOS_MAP_LENGTH; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        segment[i] = (seed >> 16) & 7 ? (seed >> 16) & 0xFF : '_';
+        /* no anchor must appear by chance, the 'M' of "_SM_", "_SM3" and "_DMI" follows the '_' by two */
+        if (i >= 2 && segment[i - 2] == '_' && segment[i] == 'M')
+            segment[i] = 'X';
+    }
+
+    start = get_cycles ();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+        smbios_scan_anchors (segment, BIOS_MAP_LENGTH, &anchors);
+    cycles = get_cycles () - start;
+
+    vfree (segment);
+
+    average = cycles;
+    do_div (average, BENCH_ROUNDS);
+
+    PDEBUG ("bench: %lu cycles per scan of a 64 KB segment%s\n",
+            (unsigned long) average,
+            anchors.sm || anchors.sm3 || anchors.dmi ? " (anchor found by chance)" : "");
+}
+
+/** \fn static unsigned int bench_struct_length_bytewise (unsigned char *struct_ptr, unsigned int limit)
+ *  \brief byte by byte search for the end of a structure, the reference for smbios_bench_struct_length()
+ *  \param struct_ptr pointer to a SM-BIOS structure
+ *  \param limit number of bytes from struct_ptr to the end of the table
+ *  \return length of the structure including optional strings, 0 if it does not end within limit bytes
+ */
+
+static unsigned int
+bench_struct_length_bytewise (unsigned char *struct_ptr, unsigned int limit)
+{
+    unsigned int i;
+
+
+    for (i = struct_ptr[1]; i + 1 < limit; i++)
+        if (struct_ptr[i] == 0x00 && struct_ptr[i + 1] == 0x00)
+            return i + 2;
+
+    return 0;
+}
+
+
+/** \fn void smbios_bench_struct_length (void)
+ *  \brief measures the time needed to find the end of the structures
+ *
+ *  A synthetic 64 KB table is built from structures with long string
+ *  sections, every structure has eight strings of 8 to 255 characters.
+ *  The table is walked BENCH_ROUNDS times with smbios_get_struct_length()
+ *  and with a byte by byte search. Both walks must find the same number
+ *  of structures.
+ */
+
+void
+smbios_bench_struct_length (void)
+{
+    unsigned char *table;
+    unsigned int seed = 1;
+    unsigned int offset;
+    unsigned int length;
+    unsigned int walked[2] = { 0, 0 };
+    unsigned int i, j;
+    cycles_t start;
+    cycles_t cycles[2];
+    __u64 average[2];
+
+
+    if (!(table = vmalloc (BIOS_MAP_LENGTH)))
+        return;
+
+    memset (table, 0, BIOS_MAP_LENGTH);
+
+    /* header of 0x10 bytes, eight strings, terminating 0x00. The rest of
+     * the table is left 0x00, a structure that does not fit is cut off
+     * and has no terminator within the table.
+     */
+    for (offset = 0; offset + 0x10 < BIOS_MAP_LENGTH; offset++)
+    {
+        table[offset] = 0x80;
+        table[offset + 1] = 0x10;
+        offset += 0x10;
+
+        for (i = 0; i < 8 && offset < BIOS_MAP_LENGTH; i++, offset++)
+        {
+            seed = seed * 1103515245 + 12345;
+            length = 8 + ((seed >> 16) % 248);
+
+            for (j = 0; j < length && offset < BIOS_MAP_LENGTH; j++, offset++)
+                table[offset] = 'A' + (j % 26);
+        }
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        start = get_cycles ();
+
+        for (j = 0; j < BENCH_ROUNDS; j++)
+        {
+            walked[i] = 0;
+
+            for (offset = 0; offset + SMBIOS_HEADER_LENGTH <= BIOS_MAP_LENGTH; offset += length)
+            {
+                if (i == 0)
+                    length = smbios_get_struct_length ((smbios_struct *) (table + offset), BIOS_MAP_LENGTH - offset);
+                else
+                    length = bench_struct_length_bytewise (table + offset, BIOS_MAP_LENGTH - offset);
+
+                if (!length)
+                    break;
+
+                walked[i]++;
+            }
+        }
+
+        cycles[i] = get_cycles () - start;
+    }
+
+    vfree (table);
+
+    for (i = 0; i < 2; i++)
+    {
+        average[i] = cycles[i];
+        do_div (average[i], BENCH_ROUNDS);
+    }
+
+    PDEBUG ("bench: %u structures, %lu cycles per walk a word at a time, %lu byte by byte%s\n",
+            walked[0], (unsigned long) average[0], (unsigned long) average[1],
+            walked[0] != walked[1] ? " (MISMATCH)" : "");
+}
+
+#endif /* _DEBUG_ */
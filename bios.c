@@ -58,6 +58,19 @@
 #include <linux/types.h>	/* ... fixed size types definitions, '__u8'... */
 #include <linux/proc_fs.h>	/* ... for 'struct proc_dir_entry' */
 #include <linux/string.h>	/* ... for 'memcpy()', 'strncmp()' */
+#include <linux/fs.h>		/* ... for 'struct file_operations' */
+#include <linux/seq_file.h>	/* ... for 'seq_read()' */
+#include <linux/vmalloc.h>	/* ... for 'vmalloc()' */
+#include <linux/slab.h>		/* ... for 'kmem_cache_create()' */
+#include <linux/mm.h>		/* ... for 'remap_page_range()' */
+#include <linux/wrapper.h>	/* ... for 'mem_map_reserve()' */
+#include <asm/io.h>		    /* ... for 'iounmap()', 'memcpy_fromio()' */
+#ifdef CONFIG_EFI
+#include <linux/efi.h>		/* ... for 'efi.smbios' */
+#endif
+#include <asm/semaphore.h>	/* ... for 'DECLARE_MUTEX()' */
+#include <asm/atomic.h>		/* ... for 'atomic_inc()' */
+#include <asm/uaccess.h>	/* ... for 'copy_to_user()' */
 
 #include "strgdef.h"        /* ... contains the string definitions for the cooked mode */
 #include "bios.h"		    /* ... local declarations for DMI-, SM-BIOS */
@@ -76,18 +89,170 @@ struct proc_dir_entry *smbios_proc_dir = 0;
 struct proc_dir_entry *smbios_raw_proc_dir = 0;
 /** SM-BIOS, resp. DMI-BIOS /proc/smbios/cooked directory */
 struct proc_dir_entry *smbios_cooked_proc_dir = 0;
+/** SM-BIOS, resp. DMI-BIOS /proc/smbios/keyvalue directory */
+struct proc_dir_entry *smbios_keyvalue_proc_dir = 0;
+/** SM-BIOS, resp. DMI-BIOS /proc/smbios/binary directory */
+struct proc_dir_entry *smbios_binary_proc_dir = 0;
 /** SM-BIOS, resp. DMI-BIOS virtual base address of F-Segment */
 void *smbios_base = 0;
 /** SM-BIOS entry point structure */
 smbios_entry_point_struct *smbios_entry_point = 0;
+/** SM-BIOS 3.0 entry point structure */
+smbios3_entry_point_struct *smbios3_entry_point = 0;
 /** DMI-BIOS entry point structure */
 dmibios_entry_point_struct *dmibios_entry_point = 0;
 /** SM-BIOS, resp. DMI-BIOS structures base address; starting point */
 void *smbios_structures_base = 0;
+/** SM-BIOS physical structure table address, taken from the entry point */
+__u64 smbios_table_address = 0;
+/** SM-BIOS structure table length, taken from the entry point */
+__u32 smbios_table_length = 0;
 /** enumeration of SM-BIOS, resp. DMI-BIOS types that do have subtypes */
-__u8 smbios_types_with_subtypes[] = { TYPES_WITH_SUBTYPES };
+__u8 smbios_types_with_subtypes[NO_OF_TYPES_WITH_SUBTYPES] = { TYPES_WITH_SUBTYPES };
 /** contains the SMBIOS Version, e.g. V2.31 */
 char smbios_version_string[32];
+/** 1 if the tables are read from a copy in kernel memory, see smbios_snapshot() */
+int smbios_snapshot_taken = 0;
+/** load-time index of all SM-BIOS, resp. DMI-BIOS structures */
+smbios_index_entry *smbios_index = 0;
+/** number of records in use in smbios_index */
+unsigned int smbios_index_count = 0;
+/** number of records allocated for smbios_index */
+static unsigned int smbios_index_size = 0;
+/** base address the index offsets are relative to */
+void *smbios_index_base = 0;
+/** strings of all structures, in the order of smbios_index */
+smbios_string_ref *smbios_string_refs = 0;
+/** number of records in use in smbios_string_refs */
+static unsigned int smbios_string_count = 0;
+/** number of records allocated for smbios_string_refs */
+static unsigned int smbios_string_size = 0;
+/** DMI-BIOS structures converted to SM-BIOS format, see dmibios_make_dir_entries() */
+static unsigned char *smbios_dmi_images = 0;
+/** handle lookup table, maps a structure handle to its position in smbios_index */
+static __u32 *smbios_handle_table = 0;
+/** number of slots in smbios_handle_table minus 1, the number of slots is a power of 2 */
+static unsigned int smbios_handle_mask = 0;
+/** read-only image of the index, the strings and the table, see smbios_build_map() */
+static unsigned char *smbios_map = 0;
+/** length of the image in smbios_map */
+static unsigned int smbios_map_length = 0;
+/** smbios_map is made of 2^smbios_map_order pages */
+static unsigned int smbios_map_order = 0;
+/** cooked text of every structure, parallel to smbios_index */
+smbios_cooked_entry *smbios_cooked_cache = 0;
+/** serializes filling smbios_cooked_cache */
+static DECLARE_MUTEX (smbios_cooked_lock);
+/** binary format of all structures, see smbios_open_binary_all_proc() */
+static unsigned char *smbios_binary_all = 0;
+/** length of smbios_binary_all */
+static unsigned int smbios_binary_all_length = 0;
+/** slab cache of the smbios_file_buffer of every open file */
+static kmem_cache_t *smbios_buffer_cache = 0;
+/** counters of the stats file, see smbios_stats_show() */
+typedef struct smbios_stats
+{
+    /** files opened, except the stats file */
+    atomic_t opens;
+    /** smbios_file_buffer taken from, resp. given back to the slab cache */
+    atomic_t buffer_allocs;
+    atomic_t buffer_frees;
+    /** outputs rendered into the cache, each of them takes memory from kmalloc() once */
+    atomic_t renders;
+    /** outputs taken from the cache */
+    atomic_t cache_hits;
+} smbios_stats;
+/** counters shown in the stats file */
+static smbios_stats smbios_statistics;
+
+/** file operations of the raw files of SM-BIOS structures */
+static struct file_operations smbios_raw_fops = {
+    owner:      THIS_MODULE,
+    open:       bios_open_raw_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** file operations of the key=value files */
+static struct file_operations smbios_keyvalue_fops = {
+    owner:      THIS_MODULE,
+    open:       bios_open_keyvalue_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** file operations of the binary files */
+static struct file_operations smbios_binary_fops = {
+    owner:      THIS_MODULE,
+    open:       bios_open_binary_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** file operations of the binary file of all structures */
+static struct file_operations smbios_binary_all_fops = {
+    owner:      THIS_MODULE,
+    open:       smbios_open_binary_all_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** file operations of the cooked files */
+static struct file_operations smbios_cooked_fops = {
+    owner:      THIS_MODULE,
+    open:       bios_open_cooked_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** file operations of the smbios_version file */
+static struct file_operations smbios_version_fops = {
+    owner:      THIS_MODULE,
+    open:       smbios_open_version_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** file operations of the table and entry_point files */
+static struct file_operations smbios_table_fops = {
+    owner:      THIS_MODULE,
+    open:       smbios_open_table_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    release:    smbios_release_proc,
+};
+/** iterator over the index for the all file */
+static struct seq_operations smbios_all_seqops = {
+    start:      smbios_all_start,
+    next:       smbios_all_next,
+    stop:       smbios_all_stop,
+    show:       smbios_all_show,
+};
+/** file operations of the all file */
+static struct file_operations smbios_all_fops = {
+    owner:      THIS_MODULE,
+    open:       smbios_open_all_proc,
+    read:       seq_read,
+    llseek:     seq_lseek,
+    release:    seq_release,
+};
+/** file operations of the stats file */
+static struct file_operations smbios_stats_fops = {
+    owner:      THIS_MODULE,
+    open:       smbios_open_stats_proc,
+    read:       seq_read,
+    llseek:     seq_lseek,
+    release:    single_release,
+};
+/** file operations of the map file */
+static struct file_operations smbios_map_fops = {
+    owner:      THIS_MODULE,
+    open:       smbios_open_table_proc,
+    read:       smbios_read_proc,
+    llseek:     smbios_llseek_proc,
+    mmap:       smbios_mmap_map_proc,
+    release:    smbios_release_proc,
+};
 
 
 
@@ -98,96 +263,130 @@ char smbios_version_string[32];
 
 
 
-/** \fn smbios_entry_point_struct * smbios_find_entry_point (void *base)
-  * \brief find the SM-BIOS entry point structure 
-  * \param base virtual base address of physical F-segment address 
-  * \return pointer to the SM-BIOS entry point structure
-  *
-  * this function searches the BIOS F-segement (physical address 0x000f0000
-  * to 0x000fffff) for the SM-BIOS entry point signature '_SM_'.
+/** \fn void smbios_scan_anchors (void *base, unsigned int length, smbios_anchors *anchors)
+  * \brief find the SM-BIOS, SM-BIOS 3.0 and DMI-BIOS entry point structures
+  * \param base virtual base address of physical F-segment address
+  * \param length length of the area to scan, BIOS_MAP_LENGTH for the F-segment
+  * \param anchors [OUT]-Param. the entry points found, NULL if not found
   *
-  * \author Markus Lyra
-  * \author Thomas Bretthauer
-  * \date October 2000
+  * this function searches the BIOS F-segment (physical address 0x000f0000
+  * to 0x000fffff) for all entry points in one pass:
+  * - '_SM_' and '_SM3_' on paragraph boundaries. Each paragraph is checked
+  *   with a single dword compare. Only entry points with correct checksum
+  *   are taken, the first valid one of each kind. The scan stops once both
+  *   are found, the '_SM_' entry point is needed if the table of the '_SM3_'
+  *   entry point can't be mapped.
+  * - the proprietary DMI-BIOS signature '_DMI' on byte boundaries, as long as
+  *   no SM-BIOS entry point was found. A word is only looked at byte by byte
+  *   if it contains an '_' at all.
   */
 
-smbios_entry_point_struct *
-smbios_find_entry_point (void *base)
+void
+smbios_scan_anchors (void *base, unsigned int length, smbios_anchors *anchors)
 {
-    smbios_entry_point_struct *entry_point = 0;	/** SM-BIOS entry point */
-    unsigned long *temp;				        /** temp. pointer       */
+    unsigned char *end = (unsigned char *) base + length;
+    unsigned char *paragraph;
+    unsigned char *temp;
+    unsigned long *word;
+    __u32 anchor;
+    unsigned int i;
+
+
+    anchors->sm = 0;
+    anchors->sm3 = 0;
+    anchors->dmi = 0;
+
+    for (paragraph = base; paragraph + 16 <= end; paragraph += 16)
+    {
+        anchor = *(__u32 *) paragraph;
+
+        if (anchor == SMBIOS_MAGIC_DWORD && !anchors->sm &&
+            paragraph + sizeof (smbios_entry_point_struct) <= end &&
+            paragraph + ((smbios_entry_point_struct *) paragraph)->entry_point_length <= end &&
+            !smbios_check_entry_point (paragraph))
+        {
+            anchors->sm = (smbios_entry_point_struct *) paragraph;
+        }
+
+        if (anchor == SMBIOS3_MAGIC_DWORD && paragraph[4] == '_' && !anchors->sm3 &&
+            paragraph + sizeof (smbios3_entry_point_struct) <= end &&
+            ((smbios3_entry_point_struct *) paragraph)->entry_point_length >= sizeof (smbios3_entry_point_struct) &&
+            paragraph + ((smbios3_entry_point_struct *) paragraph)->entry_point_length <= end &&
+            !smbios3_check_entry_point (paragraph))
+        {
+            anchors->sm3 = (smbios3_entry_point_struct *) paragraph;
+        }
 
+        if (anchors->sm && anchors->sm3)
+            return;
 
-    /* search for the magic dword - '_SM_ as DWORD formatted -  on paragraph boundaries */
-    for (temp = base;
-				!entry_point && temp < (unsigned long *) base + BIOS_MAP_LENGTH;
-	      temp += 4)
-	{
-        /* found the identifier ? */
-        if (*temp == SMBIOS_MAGIC_DWORD)
+        /* the DMI-BIOS is only of interest if there is no SM-BIOS */
+        if (anchors->sm || anchors->dmi)
+            continue;
+
+        for (word = (unsigned long *) paragraph; word < (unsigned long *) (paragraph + 16); word++)
         {
-            /* check if entry point valid (build checksum) */
-	        if (!(smbios_check_entry_point (temp)))
-	        {
-	            entry_point = (smbios_entry_point_struct *) temp;
-				
-				/* fix display of Bios version string */
-			    /* SMBios version is known as 2.1, 2.2, 2.3 and 2.3.1, never as 2.01 (JB) */
-	            PDEBUG ("SM-BIOS V%d.%d entry point found at 0x%x\n",
-		        entry_point->major_version, entry_point->minor_version, (unsigned int) temp);
-
-                sprintf(smbios_version_string, "V%d.%d\n", entry_point->major_version, entry_point->minor_version);
-	        }
+            if (!HAS_BYTE (*word, '_'))
+                continue;
+
+            for (i = 0, temp = (unsigned char *) word; i < sizeof (unsigned long); i++, temp++)
+            {
+                /* found the identifier '_DMI' ?     (beginning of signature) */
+                if (*temp == '_' && temp + DMIBIOS_SCAN_RESERVE < end &&
+                    *(__u32 *) temp == DMIBIOS_MAGIC_DWORD)
+                {
+                    anchors->dmi = (dmibios_entry_point_struct *) temp;
+                    break;
+                }
+            }
+
+            if (anchors->dmi)
+                break;
         }
     }
-    return entry_point;
 }
 
 
-/** \fn dmibios_entry_point_struct * dmibios_find_entry_point (void *base)
-  * \brief find the DMI-BIOS entry point structure
-  * \param base virtual base address of physical F-segment address
-  * \return pointer to the DMI-BIOS entry point structure
-  *
-  * this function searches the BIOS F-segment (physical address 0x000f0000
-  * to 0x000fffff) for the DMI-BIOS entry point signature '_DMI20_NT_'.
-	* dmibios_find_entry_point only gets called if we couldn't find a SMBios.
-  *
-  * \author Thomas Bretthauer
-  * \date November 2000
-  */
+/** \fn void smbios_set_version_string (void)
+ *  \brief formats the version of the SM-BIOS, resp. DMI-BIOS found
+ *
+ *  smbios_version_string is set to e.g. "V2.3" for SM-BIOS or "V21" for
+ *  DMI-BIOS, the version is taken from the entry point in use.
+ */
 
-dmibios_entry_point_struct *
-dmibios_find_entry_point (void *base)
+void
+smbios_set_version_string (void)
 {
-    dmibios_entry_point_struct *entry_point = 0;	    /** DMI-BIOS entry point */
-    unsigned char *temp = 0;			                /** temp. pointer        */
-    unsigned char biossignature[] =		                /** '_DMI20_NT_'         */
-                { 0x5f, 0x44, 0x4d, 0x49, 0x32, 0x30, 0x5f, 0x4e, 0x54, 0x5f };
+	/* fix display of Bios version string */
+    /* SMBios version is known as 2.1, 2.2, 2.3 and 2.3.1, never as 2.01 (JB) */
+    if (smbios3_entry_point)
+        sprintf (smbios_version_string, "V%d.%d\n",
+                 smbios3_entry_point->major_version, smbios3_entry_point->minor_version);
+    else if (smbios_entry_point)
+        sprintf (smbios_version_string, "V%d.%d\n",
+                 smbios_entry_point->major_version, smbios_entry_point->minor_version);
+    else if (dmibios_entry_point)
+        sprintf (smbios_version_string, "V%d\n", dmibios_entry_point->revision);
+}
 
-    /* search for the DMI-BIOS signature on character boundary (hm?) */
-    for (temp = base;
-	       !entry_point && 
-				 temp < (__u8 *) base + BIOS_MAP_LENGTH - sizeof (biossignature) - 32;
-	       temp++)
-	{
-        unsigned long *tempdword = (unsigned long *) temp;
 
-        /* found the identifier '_DMI' ?     (beginning of signature) */
-        if (*tempdword == DMIBIOS_MAGIC_DWORD)
-        {
-	        entry_point = (dmibios_entry_point_struct *) temp;
-	
-	        PDEBUG ("DMI-BIOS revision %d entry point at 0x%x\n",
-		    entry_point->revision, (unsigned int) temp);
+/** \fn unsigned long smbios_firmware_entry_point (void)
+ *  \brief returns the physical address of the entry point known to the firmware
+ *  \return physical address of the SM-BIOS entry point, 0 if unknown
+ *
+ *  On EFI machines the EFI system table holds the address of the entry
+ *  point, there is no need to scan the F-segment.
+ */
 
-            sprintf(smbios_version_string, "V%d\n", entry_point->revision);
+unsigned long
+smbios_firmware_entry_point (void)
+{
+#ifdef CONFIG_EFI
+    if (efi.smbios)
+        return __pa (efi.smbios);
+#endif
 
-	        if (memcmp (temp, biossignature, sizeof (biossignature)) == 0)
-	            PDEBUG ("DMI BIOS successfully identified\n");
-        }
-    }
-    return entry_point;
+    return 0;
 }
 
 
@@ -223,6 +422,52 @@ smbios_check_entry_point (void *addr)
 }
 
 
+/** \fn unsigned char smbios_check_intermediate_entry_point (void * addr)
+ *  \brief checks the intermediate entry point structure for correct checksum
+ *  \param addr pointer to the entry point structure
+ *  \return the checksum of the intermediate entry point structure, should be '0'
+ *
+ *  The intermediate entry point structure starts with the '_DMI_' anchor
+ *  at offset 10h of the entry point structure and is 0Fh bytes long.
+ */
+
+unsigned char
+smbios_check_intermediate_entry_point (void *addr)
+{
+    unsigned char *i;
+    unsigned char checksum = 0;
+    unsigned char *start = ((smbios_entry_point_struct *) addr)->intermediate_string;
+
+
+    for (i = start; i < start + 0x0F; i++)
+        checksum += *i;
+
+    return checksum;
+}
+
+
+/** \fn unsigned char smbios3_check_entry_point (void * addr)
+ *  \brief checks the SM-BIOS 3.0 entry point structure for correct checksum
+ *  \param addr pointer to the entry point structure
+ *  \return the checksum of the entry point structure, should be '0'
+ */
+
+unsigned char
+smbios3_check_entry_point (void *addr)
+{
+    unsigned char *i;
+    unsigned char checksum = 0;
+    unsigned char length =
+      ((smbios3_entry_point_struct *) addr)->entry_point_length;
+
+
+    for (i = (unsigned char *) addr; i < (unsigned char *) addr + length; i++)
+        checksum += *i;
+
+    return checksum;
+}
+
+
 /** \fn int smbios_type_has_subtype (unsigned char type)
  *  \brief returns whether the specified type does have subtypes
  *  \param type type which is checked for having subtypes
@@ -253,38 +498,71 @@ smbios_type_has_subtype (unsigned char type)
 }
 
 
-/** \fn int smbios_get_struct_length (smbios_struct * struct_ptr)
+/** \fn int smbios_get_struct_length (smbios_struct * struct_ptr, unsigned int limit)
  *  \brief returns the length of the specified SM-BIOS structure 
  *  \param struct_ptr pointer to a SM-BIOS structure
- *  \return length of the structure including optional strings
+ *  \param limit number of bytes from struct_ptr to the end of the table
+ *  \return length of the structure including optional strings, 0 if the
+ *          structure does not end within limit bytes
  *
  *  This function calculates the length of the specified SM-BIOS structure
  *  including any string following the structure.
  *
+ *  The string list is searched for the terminating 0x0000 a word at a
+ *  time, only a word that holds a 0x00 byte is looked at byte by byte.
+ *  No byte at or behind struct_ptr + limit is read.
+ *
  *  \author Markus Lyra
  *  \author Thomas Bretthauer
  *  \date October 2000
  */
 
 int
-smbios_get_struct_length (smbios_struct * struct_ptr)
+smbios_get_struct_length (smbios_struct * struct_ptr, unsigned int limit)
 {
+    unsigned char *start = (unsigned char *) struct_ptr;
+    unsigned char *end = start + limit;
+    unsigned char *ptr;
+    unsigned long *word;
+
+
+    if (limit < SMBIOS_HEADER_LENGTH || struct_ptr->length + 2 > limit)
+        return 0;
+
     /* jump to string list */
-    unsigned char *ptr = (unsigned char *) struct_ptr + struct_ptr->length;
+    ptr = start + struct_ptr->length;
+
+    /* byte by byte up to the first word boundary */
+    for (; ptr + 1 < end && ((unsigned long) ptr & (sizeof (unsigned long) - 1)); ptr++)
+        if (ptr[0] == 0x00 && ptr[1] == 0x00)
+            return ptr + 2 - start;	/* terminating 0x0000 should be included */
+
+    /* a word at a time, the byte behind the word must be readable as well */
+    for (word = (unsigned long *) ptr; (unsigned char *) (word + 1) < end; word++)
+    {
+        if (!HAS_ZERO (*word))
+            continue;
+
+        for (ptr = (unsigned char *) word; ptr < (unsigned char *) (word + 1); ptr++)
+            if (ptr[0] == 0x00 && ptr[1] == 0x00)
+                return ptr + 2 - start;
+    }
 
-    /* search for the end of string list */
-    while (ptr[0] != 0x00 || ptr[1] != 0x00)
-        ptr++;
-    ptr += 2;			/* terminating 0x0000 should be included */
+    /* byte by byte behind the last word */
+    for (ptr = (unsigned char *) word; ptr + 1 < end; ptr++)
+        if (ptr[0] == 0x00 && ptr[1] == 0x00)
+            return ptr + 2 - start;
 
-    return (int) ptr - (int) struct_ptr;
+    return 0;
 }
 
 
-/** \fn int dmibios_get_struct_length (smbios_struct * struct_ptr)
+/** \fn int dmibios_get_struct_length (smbios_struct * struct_ptr, unsigned int limit)
  *  \brief returns the length of the specified DMI-BIOS structure 
  *  \param struct_ptr pointer to a DMI-BIOS structure
- *  \return length of the structure including optional strings
+ *  \param limit number of bytes from struct_ptr to the end of the F-segment
+ *  \return length of the structure including optional strings, 0 if the
+ *          structure or one of its strings does not end within the F-segment
  *
  *  This functions calculates the length of the specified DMI-BIOS structure
  *  including any string following the structure.
@@ -293,12 +571,19 @@ smbios_get_struct_length (smbios_struct * struct_ptr)
  *  \date November 2000
  */
 int
-dmibios_get_struct_length (smbios_struct * struct_ptr)
+dmibios_get_struct_length (smbios_struct * struct_ptr, unsigned int limit)
 {
     int len = struct_ptr->length;
+    unsigned short *ptr;
+    unsigned short *end;
+
+
+    if (limit < SMBIOS_HEADER_LENGTH || len + sizeof (unsigned short) > limit)
+        return 0;
 
     /* jump to the string list */
-    unsigned short *ptr = (unsigned short *) ((unsigned char *) struct_ptr + len);
+    ptr = (unsigned short *) ((unsigned char *) struct_ptr + len);
+    end = (unsigned short *) ((unsigned char *) struct_ptr + limit);
 
     if (*ptr == 0)
         len++;
@@ -310,520 +595,1856 @@ dmibios_get_struct_length (smbios_struct * struct_ptr)
         int stringlen;
 
         string = (unsigned char *) smbios_base + *ptr;
-        stringlen = strlen (string) + 1;
-        len += stringlen;
-        ptr++;
+        stringlen = strnlen (string, BIOS_MAP_LENGTH - *ptr);
+        if (stringlen == BIOS_MAP_LENGTH - *ptr)
+            return 0;
+
+        len += stringlen + 1;
+
+        /* the list ends with a 0x0000 pointer */
+        if (++ptr + 1 > end)
+            return 0;
     }
 
     return len + 1;
 }
 
 
-/** \fn int bios_read_raw__proc (char *page, char **start, off_t off,
- *                                 int count,int *eof, void *data)
- *  \brief called by the kernel whenever a raw proc file is read by an application
- *
- *  \param page
- *  \param start
- *  \param off
- *  \param count
- *  \param eof
- *  \param data
- *  \return bytes returned
- *
- *  This function is called by the kernel whenever an application opens
- *  a file in the proc file system created by this driver.
- *  This routine returns the appropriate data "in the file", i.e. the
- *  binary data of the corresponding SM-BIOS structure.
+/** \fn int smbios_open_buffer (struct file *file, unsigned char *data, unsigned int length)
+ *  \brief attaches the content of a file to an open file
+ *  \param file the open file
+ *  \param data content of the file
+ *  \param length length of the content
+ *  \return -ENOMEM if not enough memory, 0 otherwise
  *
- *  \author Markus Lyra
- *  \author Thomas Bretthauer
- *  \date October 2000
+ *  The content of every file of the proc file system created by this
+ *  driver is known once the file is opened. It is described by a
+ *  smbios_file_buffer that is kept in the private data of the open file,
+ *  so read and seek only have to copy from it. The buffer is taken from
+ *  smbios_buffer_cache, so opening a file does not use kmalloc().
  */
 
-int
-bios_read_raw_proc (char *page, char **start, off_t off,
-		  int count, int *eof, void *data)
+static int
+smbios_open_buffer (struct file *file, unsigned char *data, unsigned int length)
 {
-    int length = smbios_get_struct_length ((smbios_struct *) data);
-
-    /* this function is called by the kernel if a file is read, */
-    /* page points to a free page allocated by kernel,          */
-    /* data points to the structure associated with the file    */
-
-    if (off >= length)
-    {
-        *eof = 1;
+    smbios_file_buffer *buffer;
 
-        return 0;
-    }
 
-    if (off + count > length)
-    {
-        *eof = 1;
+    atomic_inc (&smbios_statistics.opens);
 
-        count = length - off;
-    }
+    if (!(buffer = kmem_cache_alloc (smbios_buffer_cache, GFP_KERNEL)))
+        return -ENOMEM;
 
-    /* don't return more than PROC_BLOCK_SIZE bytes */
-    if (count > PROC_BLOCK_SIZE)
-        count = PROC_BLOCK_SIZE;
+    atomic_inc (&smbios_statistics.buffer_allocs);
 
-    memcpy (page, data + off, count);
+    buffer->data = data;
+    buffer->length = length;
 
-    *start = page;
+    file->private_data = buffer;
 
-    return count;
+    return 0;
 }
 
 
-/** \fn int dmibios_read_raw_proc (char *page, char **start, off_t off,
- *                                 int count,int *eof, void *data)
- *  \brief called by the kernel whenever a proc file is read by an application
- *  \param page
- *  \param start
- *  \param off
- *  \param count
- *  \param eof
- *  \param data
- *  \return bytes returned
- *
- *  This function is called by the kernel whenever an application opens
- *  a file in the proc file system created by this driver.
- *  This routine returns the appropriate data "in the file", i.e. the
- *  binary data of the corresponding DMI-BIOS structure.
+/** \fn int bios_open_raw_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever a raw proc file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ENOMEM if not enough memory, 0 otherwise
  *
- *  \author Thomas Bretthauer
- *  \date November 2000
+ *  The content of the file is the binary data of the corresponding SM-BIOS
+ *  structure. It is read straight from the structure table, resp. from the
+ *  image a DMI-BIOS structure was converted to at load time.
  */
 
 int
-dmibios_read_raw_proc (char *page, char **start, off_t off,
-		   int count, int *eof, void *data)
+bios_open_raw_proc (struct inode *inode, struct file *file)
 {
-    /* this function is called by the kernel if a file is read, */
-    /* page points to a free page allocated by kernel,          */
-    /* data points to the structure associated with the file    */
-
-    unsigned char *scratch;
-    unsigned short *stringentry;
-    unsigned long bytestoadd;
+    smbios_index_entry *entry = (smbios_index_entry *) SMBIOS_PDE (inode)->data;
 
 
-    int length = dmibios_get_struct_length ((smbios_struct *) data);
+    return smbios_open_buffer (file, (unsigned char *) smbios_index_struct (entry), entry->length);
+}
 
-    /* build a scratch buffer to simulate a SM-BIOS structure */
-    scratch = kmalloc (length + 1, GFP_KERNEL);
-    if (scratch == NULL)
-    {
-        *eof = 1;
 
-        return 0;
-    }
+/** \fn int bios_open_cooked_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever a cooked proc file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The content of the file is the interpreted data of the corresponding
+ *  SM-BIOS, resp. DMI-BIOS structure, taken from the cooked text cache.
+ */
 
-    /* copy the DMI structure into this scratch buffer */
-    stringentry = (unsigned short *) ((unsigned char *) data +
-			  ((smbios_struct *) data)->length);
-    bytestoadd = ((smbios_struct *) data)->length;
+int
+bios_open_cooked_proc (struct inode *inode, struct file *file)
+{
+    unsigned char *text;
+    unsigned int length;
+    int err;
 
-    memcpy (scratch, data, bytestoadd);
 
-    if (*stringentry == 0)
-    {
-        unsigned char stringtermination = 0;
+    if ((err = smbios_get_cooked ((smbios_index_entry *) SMBIOS_PDE (inode)->data, &text, &length)))
+        return err;
 
-        memcpy (&scratch[bytestoadd], &stringtermination,
-	      sizeof (stringtermination));
-        bytestoadd += sizeof (stringtermination);
-    }
+    return smbios_open_buffer (file, text, length);
+}
 
-    while (*stringentry != 0)
-    {
-        unsigned char *string;
-        int stringlen;
 
-        string = (unsigned char *) smbios_base + *stringentry;
-        stringlen = strlen (string) + 1;
-        memcpy (&scratch[bytestoadd], string, stringlen);
-        bytestoadd += stringlen;
-        stringentry++;
-    }
-    {
-        unsigned char stringtermination = 0;
+/** \fn int bios_open_keyvalue_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever a key=value proc file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The content of the file is the interpreted data of the corresponding
+ *  structure as key=value lines, see bios_cook_keyvalue().
+ */
 
-        memcpy (&scratch[bytestoadd], &stringtermination,
-	      sizeof (stringtermination));
-    }
+int
+bios_open_keyvalue_proc (struct inode *inode, struct file *file)
+{
+    unsigned char *text;
+    unsigned int length;
+    int err;
 
-    if (off >= length)
-    {
-        *eof = 1;
 
-        return 0;
-    }
+    if ((err = smbios_get_keyvalue ((smbios_index_entry *) SMBIOS_PDE (inode)->data, &text, &length)))
+        return err;
 
-    if (off + count > length)
-    {
-        *eof = 1;
+    return smbios_open_buffer (file, text, length);
+}
 
-        count = length - off;
-    }
 
-    /* don't return more than PROC_BLOCK_SIZE bytes! */
-    if (count > PROC_BLOCK_SIZE)
-        count = PROC_BLOCK_SIZE;
+/** \fn int bios_open_binary_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever a binary proc file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The content of the file is the corresponding structure in the binary
+ *  format, see bios_cook_binary().
+ */
 
-    memcpy (page, scratch + off, count);
+int
+bios_open_binary_proc (struct inode *inode, struct file *file)
+{
+    unsigned char *data;
+    unsigned int length;
+    int err;
 
-	kfree(scratch);
 
-    *start = page;
+    if ((err = smbios_get_binary ((smbios_index_entry *) SMBIOS_PDE (inode)->data, &data, &length)))
+        return err;
 
-    return count;
+    return smbios_open_buffer (file, data, length);
 }
 
 
-/** \fn int smbios_version_proc (char *page, char **start, off_t off,
- *                                    int count,int *eof, void *data)
- *  \brief called by the kernel whenever a proc file is read by an application
- *  \param page
- *  \param start
- *  \param off
- *  \param count
- *  \param eof
- *  \param data
- *  \return bytes returned
- *
- *  This function is called by the kernel whenever an application opens
- *  a file in the proc file system created by this driver.
- *  This routine returns the appropriate data "in the file", i.e. the
- *  interpreted data of the corresponding DMI-BIOS structure.
+/** \fn int smbios_open_binary_all_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever the binary file of all structures is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
  *
- *  \author Thomas Bretthauer
- *  \date January 2001
+ *  The content of the file is every structure in the binary format, in the
+ *  order of the table. Each record starts with a smbios_tlv_header that
+ *  gives its length, so the records are simply put one after the other.
+ *  The records are put together on the first open only and kept in
+ *  smbios_binary_all, just like the outputs of the single structures.
+ *  They are taken from vmalloc(), all of them may be more than kmalloc()
+ *  gives.
  */
 
 int
-smbios_version_proc (char *page, char **start, off_t off,
-		   int count, int *eof, void *data)
+smbios_open_binary_all_proc (struct inode *inode, struct file *file)
 {
-    /* this function is called by the kernel if a file is read, */
-    /* page points to a free page allocated by kernel,          */
-    /* data points to the structure associated with the file    */
-
     unsigned char *scratch;
-	unsigned int length;
+    unsigned char *data;
+    unsigned int length;
+    unsigned int total = 0;
+    unsigned int i;
+    int err;
 
 
-    /* build the buffer with the information to present */
-    scratch = (char *) data;
-    length = strlen (scratch);
+    if (down_interruptible (&smbios_cooked_lock))
+        return -ERESTARTSYS;
 
-    if (scratch == NULL)
-    {
-        *eof = 1;
+    data = smbios_binary_all;
+    length = smbios_binary_all_length;
 
-        return 0;
-    }
+    up (&smbios_cooked_lock);
 
-    if (off >= length)
+    if (data)
     {
-        *eof = 1;
+        atomic_inc (&smbios_statistics.cache_hits);
+        return smbios_open_buffer (file, data, length);
+    }
 
-        return 0;
+    /* convert every structure first, so the total length is known */
+    for (i = 0; i < smbios_index_count; i++)
+    {
+        if ((err = smbios_get_binary (&smbios_index[i], &data, &length)))
+            return err;
+        total += length;
     }
 
-    if (off + count > length)
+    if (down_interruptible (&smbios_cooked_lock))
+        return -ERESTARTSYS;
+
+    /* another open may have put the records together in the meantime */
+    if (!smbios_binary_all && (scratch = vmalloc (total ? total : 1)))
     {
-        *eof = 1;
+        for (i = 0, total = 0; i < smbios_index_count; i++)
+        {
+            memcpy (scratch + total, smbios_cooked_cache[i].binary, smbios_cooked_cache[i].binary_length);
+            total += smbios_cooked_cache[i].binary_length;
+        }
 
-        count = length - off;
+        smbios_binary_all = scratch;
+        smbios_binary_all_length = total;
+        atomic_inc (&smbios_statistics.renders);
     }
 
-    /* don't return more than PROC_BLOCK_SIZE bytes! */
-    if (count > PROC_BLOCK_SIZE)
-        count = PROC_BLOCK_SIZE;
+    data = smbios_binary_all;
+    length = smbios_binary_all_length;
 
-    memcpy (page, scratch + off, count);
+    up (&smbios_cooked_lock);
 
-    *start = page;
+    if (!data)
+        return -ENOMEM;
 
-    return count;
+    return smbios_open_buffer (file, data, length);
 }
 
 
-/** \fn int dmibios_read_cooked_proc (char *page, char **start, off_t off,
- *                                    int count,int *eof, void *data)
- *  \brief called by the kernel whenever a proc file is read by an application
- *  \param page
- *  \param start
- *  \param off
- *  \param count
- *  \param eof
- *  \param data
- *  \return bytes returned
- *
- *  This function is called by the kernel whenever an application opens
- *  a file in the proc file system created by this driver.
- *  This routine returns the appropriate data "in the file", i.e. the
- *  interpreted data of the corresponding DMI-BIOS structure.
+/** \fn int smbios_open_version_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever the version file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ENOMEM if not enough memory, 0 otherwise
  *
- *  \author Thomas Bretthauer
- *  \date January 2001
+ *  The content of the file is the SMBIOS version string, e.g. V2.31.
  */
 
 int
-bios_read_cooked_proc (char *page, char **start, off_t off,
-		   int count, int *eof, void *data)
+smbios_open_version_proc (struct inode *inode, struct file *file)
 {
-    /* this function is called by the kernel if a file is read, */
-    /* page points to a free page allocated by kernel,          */
-    /* data points to the structure associated with the file    */
+    unsigned char *version = (unsigned char *) SMBIOS_PDE (inode)->data;
 
-    unsigned char *scratch;
-	unsigned int length;
 
-    /* build the buffer with the information to present */
-    scratch = bios_cook((smbios_struct *) data, &length);
+    return smbios_open_buffer (file, version, strlen (version));
+}
 
-    if (scratch == NULL)
-    {
-        *eof = 1;
 
-        return 0;
-    }
+/** \fn int smbios_open_table_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever the table or the entry_point file is opened
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The content of the file is read directly from the structure table,
+ *  resp. the entry point, nothing is copied when the file is opened.
+ */
 
-    if (off >= length)
-    {
-        *eof = 1;
+int
+smbios_open_table_proc (struct inode *inode, struct file *file)
+{
+    struct proc_dir_entry *pde = SMBIOS_PDE (inode);
 
-        return 0;
-    }
 
-    if (off + count > length)
-    {
-        *eof = 1;
+    return smbios_open_buffer (file, (unsigned char *) pde->data, pde->size);
+}
 
-        count = length - off;
-    }
 
-    /* don't return more than PROC_BLOCK_SIZE bytes! */
-    if (count > PROC_BLOCK_SIZE)
-        count = PROC_BLOCK_SIZE;
+/** \fn void * smbios_all_start (struct seq_file *m, loff_t *pos)
+ *  \brief starts or resumes the iteration over the index for the all file
+ *  \param m the sequence file
+ *  \param pos number of the structure to start with
+ *  \return index record of the structure, NULL behind the last structure
+ */
+
+void *
+smbios_all_start (struct seq_file *m, loff_t *pos)
+{
+    if (*pos >= smbios_index_count)
+        return NULL;
+
+    return &smbios_index[*pos];
+}
 
-    memcpy (page, scratch + off, count);
 
-    kfree(scratch);
+/** \fn void * smbios_all_next (struct seq_file *m, void *v, loff_t *pos)
+ *  \brief advances the iteration to the next structure
+ *  \param m the sequence file
+ *  \param v index record of the current structure
+ *  \param pos number of the current structure, advanced by one
+ *  \return index record of the next structure, NULL behind the last structure
+ */
 
-    *start = page;
+void *
+smbios_all_next (struct seq_file *m, void *v, loff_t *pos)
+{
+    ++*pos;
 
-    return count;
+    return smbios_all_start (m, pos);
 }
 
 
-/** \fn int smbios_make_version_entry (struct proc_dir_entry *smbiosdir)
- *  \brief makes a directory entry for the proc file system
- *  \param smbiosdir pointer to proc directory where the files should be created in
- *  \return -ENOMEM if not enough memory, 0 otherwise
- *
- *  This function creates the smbios_version file in the proc file system.
+/** \fn void smbios_all_stop (struct seq_file *m, void *v)
+ *  \brief ends the iteration, nothing is held between two reads
+ *  \param m the sequence file
+ *  \param v index record of the last structure
+ */
+
+void
+smbios_all_stop (struct seq_file *m, void *v)
+{
+}
+
+
+/** \fn int smbios_all_show (struct seq_file *m, void *v)
+ *  \brief writes the cooked text of one structure to the all file
+ *  \param m the sequence file
+ *  \param v index record of the structure
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if the structure could not be cooked, 0 otherwise
  *
- *  \author Joachim Braeuer
- *  \date October 2000
+ *  The text is taken from the cooked cache, the structures are separated
+ *  by an empty line.
  */
 
 int
-smbios_make_version_entry (struct proc_dir_entry *smbiosdir)
+smbios_all_show (struct seq_file *m, void *v)
 {
-    struct proc_dir_entry *new_entry;
-	char local_filename[64];
+    unsigned char *text;
+    unsigned int length;
+    int err;
 
-	
-    /* file name */
-    strcpy(local_filename, "smbios_version");
 
-    /* create file */
-    if (!(new_entry = create_proc_entry (local_filename, S_IFREG | S_IRUGO, smbiosdir)))
-	       return -ENOMEM;
+    if ((err = smbios_get_cooked ((smbios_index_entry *) v, &text, &length)))
+        return err;
 
-    /* set data to the beginning of the string */
-    new_entry->data = smbios_version_string;
-    /* set the read function for this file */
-    new_entry->read_proc = smbios_version_proc;
-    /* set the file size */
-    new_entry->size=strlen(smbios_version_string);
+    seq_printf (m, "%.*s\n", length, text);
 
     return 0;
 }
 
 
-/** \fn int smbios_make_dir_entries (struct proc_dir_entry *smbiosdir,
- *                  struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir)
- *  \brief makes the directory entries for the proc file system
- *  \param smbiosdir pointer to proc directory where the files should be created in (/proc/smbios)
- *  \param rawdir pointer to proc directory where the files should be created in (/proc/smbios/raw)
- *  \param cookeddir pointer to proc directory where the files should be created in (/proc/smbios/cooked)
+/** \fn int smbios_open_all_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever the all file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
  *  \return -ENOMEM if not enough memory, 0 otherwise
- * 
- *  This function creates the files in the proc file system. Therefore, SM-BIOS
- *  is scanned and for every type found a file name will be created with the
- *  name of the form "type[-subtype].instance".
  *
- *  \author Markus Lyra
- *  \author Thomas Bretthauer
- *  \date October 2000
+ *  The file is a sequence file. Every read() formats only as many
+ *  structures as fit into the buffer of the sequence file, the whole
+ *  document is never held in memory.
  */
 
 int
-smbios_make_dir_entries (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir)
+smbios_open_all_proc (struct inode *inode, struct file *file)
 {
-    int i;
-    unsigned int raw_name_length = 0;	
-    char raw_name[12];                      /* e.g. 0.0 for structure type 0 , first instance */
-    unsigned int readable_name_length = 0;	
-    char readable_name[64];                 /* e.g. Bios.0 for structure type 0 , first instance */
-    smbios_struct *struct_ptr = smbios_structures_base;
+    atomic_inc (&smbios_statistics.opens);
 
+    return seq_open (file, &smbios_all_seqops);
+}
 
-    /*
-     *  for every SMBIOS structure do ...
-     */
-    for (i = 0; i < smbios_entry_point->no_of_structures; i++)
-    {
-        /*
-         *  generate an unique name for the file:  "type[-subtype].count"
-         */
-        if (smbios_type_has_subtype (((smbios_struct *) struct_ptr)->type))
-        {
-            /* name will contain the raw file name, it equals the structure type (e.g. 1 for Type 1).
-             * readable_name contains the interpreted file name (e.g. System for Type 1)
-             */
-	        raw_name_length = sprintf (raw_name, "%d-%d", struct_ptr->type, struct_ptr->subtype);
-            readable_name_length = smbios_get_readable_name_ext(readable_name, struct_ptr);
-        }
-        else
-        {
-	        raw_name_length = sprintf (raw_name, "%d", struct_ptr->type);
-            readable_name_length = smbios_get_readable_name(readable_name, struct_ptr);
-        }
 
-      
-        /*
-         *  create the file
-         */
+/** \fn int smbios_stats_show (struct seq_file *m, void *v)
+ *  \brief writes the counters to the stats file
+ *  \param m the sequence file
+ *  \param v not used
+ *  \return 0
+ *
+ *  The lines have the layout of the cooked text. After the outputs of the
+ *  structures are rendered, only the counters of the slab caches should
+ *  grow: reading a file then takes no memory from kmalloc().
+ */
+
+int
+smbios_stats_show (struct seq_file *m, void *v)
+{
+    seq_printf (m, "%-35s%s %d\n", STATS_OPENS, SEP1, atomic_read (&smbios_statistics.opens));
+    seq_printf (m, "%-35s%s %d\n", STATS_BUFFER_ALLOCS, SEP1, atomic_read (&smbios_statistics.buffer_allocs));
+    seq_printf (m, "%-35s%s %d\n", STATS_BUFFER_FREES, SEP1, atomic_read (&smbios_statistics.buffer_frees));
+    seq_printf (m, "%-35s%s %d\n", STATS_RENDERS, SEP1, atomic_read (&smbios_statistics.renders));
+    seq_printf (m, "%-35s%s %d\n", STATS_CACHE_HITS, SEP1, atomic_read (&smbios_statistics.cache_hits));
+
+    return 0;
+}
+
+
+/** \fn int smbios_open_stats_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever the stats file is opened by an application
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The counters are formatted on every read, opening the stats file is
+ *  not counted.
+ */
+
+int
+smbios_open_stats_proc (struct inode *inode, struct file *file)
+{
+    return single_open (file, smbios_stats_show, NULL);
+}
+
+
+/** \fn int smbios_mmap_map_proc (struct file *file, struct vm_area_struct *vma)
+ *  \brief called by the kernel whenever an application maps the map file
+ *  \param file the open file
+ *  \param vma the user space area to map the file into
+ *  \return -EPERM for a writable mapping, -EINVAL if the area exceeds the map,
+ *          -EAGAIN if the pages could not be mapped, 0 otherwise
+ *
+ *  The pages of smbios_map are mapped read-only. An application can look
+ *  up any structure in the mapped index without a further system call.
+ */
+
+int
+smbios_mmap_map_proc (struct file *file, struct vm_area_struct *vma)
+{
+    unsigned long offset = vma->vm_pgoff << PAGE_SHIFT;
+    unsigned long size = vma->vm_end - vma->vm_start;
+
+
+    if (vma->vm_flags & VM_WRITE)
+        return -EPERM;
+
+    if (offset >= (PAGE_SIZE << smbios_map_order) || size > (PAGE_SIZE << smbios_map_order) - offset)
+        return -EINVAL;
+
+    /* neither may mprotect() make the mapping writable */
+    vma->vm_flags &= ~VM_MAYWRITE;
+
+    if (remap_page_range (vma->vm_start, virt_to_phys (smbios_map + offset), size, vma->vm_page_prot))
+        return -EAGAIN;
+
+    return 0;
+}
+
+
+/** \fn ssize_t smbios_read_proc (struct file *file, char *buf, size_t count, loff_t *ppos)
+ *  \brief called by the kernel whenever a proc file is read by an application
+ *  \param file the open file
+ *  \param buf user space buffer
+ *  \param count size of the user space buffer
+ *  \param ppos file position, advanced by the number of bytes read
+ *  \return bytes returned, -EFAULT if buf is invalid
+ *
+ *  Copies as much of the content of the file as fits into buf, there is
+ *  no limit on the size of a single read. Used for all files created by
+ *  this driver. pread() works as well since only *ppos is used.
+ */
+
+ssize_t
+smbios_read_proc (struct file *file, char *buf, size_t count, loff_t *ppos)
+{
+    smbios_file_buffer *buffer = (smbios_file_buffer *) file->private_data;
+    loff_t pos = *ppos;
+
+
+    if (pos < 0 || pos >= buffer->length)
+        return 0;
+
+    if (count > buffer->length - pos)
+        count = buffer->length - pos;
+
+    if (copy_to_user (buf, buffer->data + pos, count))
+        return -EFAULT;
+
+    *ppos = pos + count;
+
+    return count;
+}
+
+
+/** \fn loff_t smbios_llseek_proc (struct file *file, loff_t offset, int origin)
+ *  \brief called by the kernel whenever an application seeks in a proc file
+ *  \param file the open file
+ *  \param offset new position, relative to origin
+ *  \param origin 0 for the start, 1 for the current position, 2 for the end of the file
+ *  \return new position, -EINVAL if the new position would be negative
+ */
+
+loff_t
+smbios_llseek_proc (struct file *file, loff_t offset, int origin)
+{
+    smbios_file_buffer *buffer = (smbios_file_buffer *) file->private_data;
+
+
+    switch (origin)
+    {
+        case 1: offset += file->f_pos;
+                break;
+        case 2: offset += buffer->length;
+                break;
+    }
+
+    if (offset < 0)
+        return -EINVAL;
+
+    file->f_pos = offset;
+
+    return offset;
+}
+
+
+/** \fn int smbios_release_proc (struct inode *inode, struct file *file)
+ *  \brief called by the kernel whenever a proc file is closed
+ *  \param inode inode of the proc file
+ *  \param file the open file
+ *  \return 0
+ *
+ *  Frees the state of the open file, it goes back to the slab caches.
+ */
+
+int
+smbios_release_proc (struct inode *inode, struct file *file)
+{
+    smbios_file_buffer *buffer = (smbios_file_buffer *) file->private_data;
+
+
+    kmem_cache_free (smbios_buffer_cache, buffer);
+    atomic_inc (&smbios_statistics.buffer_frees);
+
+    return 0;
+}
+
+
+/** \fn int smbios_make_version_entry (struct proc_dir_entry *smbiosdir)
+ *  \brief makes a directory entry for the proc file system
+ *  \param smbiosdir pointer to proc directory where the files should be created in
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  This function creates the smbios_version file in the proc file system.
+ *
+ *  \author Joachim Braeuer
+ *  \date October 2000
+ */
+
+int
+smbios_make_version_entry (struct proc_dir_entry *smbiosdir)
+{
+    struct proc_dir_entry *new_entry;
+	char local_filename[64];
+
+	
+    /* file name */
+    strcpy(local_filename, "smbios_version");
+
+    /* create file */
+    if (!(new_entry = create_proc_entry (local_filename, S_IFREG | S_IRUGO, smbiosdir)))
+	       return -ENOMEM;
+
+    /* set data to the beginning of the string */
+    new_entry->data = smbios_version_string;
+    /* set the file operations for this file */
+    new_entry->proc_fops = &smbios_version_fops;
+    /* set the file size */
+    new_entry->size=strlen(smbios_version_string);
+
+    return 0;
+}
+
+
+/** \fn int smbios_make_table_entries (struct proc_dir_entry *rawdir, unsigned int table_length)
+ *  \brief makes the table, the entry_point and the map file
+ *  \param rawdir pointer to proc directory where the files should be created in (/proc/smbios/raw)
+ *  \param table_length length of the structures found in the table
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The table file holds the structure table as it is found at the table
+ *  address, the entry_point file the entry point structure in use. A dump
+ *  of the whole table is read with a single read(). The DMI-BIOS has no
+ *  table of its own, the files are only made for SM-BIOS.
+ *
+ *  The table length of a SM-BIOS 3.0 entry point is only an upper bound,
+ *  so the table file ends with the last structure found. Both files are
+ *  read straight from the table and the entry point, they are only made
+ *  if these are copies in kernel memory, see smbios_snapshot().
+ */
+
+int
+smbios_make_table_entries (struct proc_dir_entry *rawdir, unsigned int table_length)
+{
+    struct proc_dir_entry *new_entry;
+
+
+    if (!(new_entry = create_proc_entry (PROC_FILE_STRING_MAP, S_IFREG | S_IRUGO, rawdir)))
+        return -ENOMEM;
+
+    new_entry->data = smbios_map;
+    new_entry->proc_fops = &smbios_map_fops;
+    new_entry->size = smbios_map_length;
+
+    if (!smbios_snapshot_taken)
+    {
+        PDEBUG ("no snapshot of the table, no table and entry_point file\n");
+        return 0;
+    }
+
+    if (!(new_entry = create_proc_entry (PROC_FILE_STRING_TABLE, S_IFREG | S_IRUGO, rawdir)))
+        return -ENOMEM;
+
+    new_entry->data = smbios_structures_base;
+    new_entry->proc_fops = &smbios_table_fops;
+    new_entry->size = table_length;
+
+    if (!(new_entry = create_proc_entry (PROC_FILE_STRING_ENTRY_POINT, S_IFREG | S_IRUGO, rawdir)))
+        return -ENOMEM;
+
+    if (smbios3_entry_point)
+    {
+        new_entry->data = smbios3_entry_point;
+        new_entry->size = smbios3_entry_point->entry_point_length;
+    }
+    else
+    {
+        new_entry->data = smbios_entry_point;
+        new_entry->size = smbios_entry_point->entry_point_length;
+    }
+    new_entry->proc_fops = &smbios_table_fops;
+
+    return 0;
+}
+
+
+/** \fn int smbios_make_dir_entries (struct proc_dir_entry *smbiosdir,
+ *                  struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir,
+ *                  struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir)
+ *  \brief makes the directory entries for the proc file system
+ *  \param smbiosdir pointer to proc directory where the files should be created in (/proc/smbios)
+ *  \param rawdir pointer to proc directory where the files should be created in (/proc/smbios/raw)
+ *  \param cookeddir pointer to proc directory where the files should be created in (/proc/smbios/cooked)
+ *  \param keyvaluedir pointer to proc directory where the files should be created in (/proc/smbios/keyvalue)
+ *  \param binarydir pointer to proc directory where the files should be created in (/proc/smbios/binary)
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ * 
+ *  This function creates the files in the proc file system. Therefore, SM-BIOS
+ *  is scanned once and every structure is recorded in the structure index.
+ *  The files are then created from the index by smbios_make_index_entries().
+ *
+ *  \author Markus Lyra
+ *  \author Thomas Bretthauer
+ *  \date October 2000
+ */
+
+int
+smbios_make_dir_entries (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir,
+                         struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir)
+{
+    unsigned int i;
+    unsigned int no_of_structures;
+    unsigned int offset;
+    unsigned int length;
+    int err;
+    smbios_struct *struct_ptr;
+    smbios_index_entry *entry;
+
+
+    /* SM-BIOS 2.x tells the number of structures. A SM-BIOS 3.0 table is
+     * walked until the end-of-table structure. Both are bounded by the
+     * length of the table.
+     */
+    no_of_structures = smbios_entry_point ? smbios_entry_point->no_of_structures : ~0U;
+
+    if ((err = smbios_alloc_index (smbios_entry_point ? no_of_structures : 64)))
+        return err;
+    smbios_index_base = smbios_structures_base;
+
+    /*
+     *  for every SMBIOS structure do ...
+     *
+     *  the length of a structure is computed exactly once, here. Everything
+     *  else uses the length stored in the index.
+     */
+    for (i = 0, offset = 0;
+         i < no_of_structures && offset + SMBIOS_HEADER_LENGTH <= smbios_table_length;
+         i++)
+    {
+        struct_ptr = (smbios_struct *) ((unsigned char *) smbios_structures_base + offset);
+
+        if (struct_ptr->length < SMBIOS_HEADER_LENGTH)
+        {
+            PDEBUG ("structure at offset %u too short, table truncated\n", offset);
+            break;
+        }
+
+        if (!(length = smbios_get_struct_length (struct_ptr, smbios_table_length - offset)))
+        {
+            PDEBUG ("structure at offset %u exceeds the table, table truncated\n", offset);
+            break;
+        }
+
+        if (length > SMBIOS_MAX_STRUCT_LENGTH)
+        {
+            PDEBUG ("structure at offset %u longer than 64 KB, table truncated\n", offset);
+            break;
+        }
+
+        if (!(entry = smbios_index_add (struct_ptr, length)))
+            return -ENOMEM;
+
+        /*
+         *  go to the next structure
+         */
+        offset += entry->length;
+
+        if (smbios3_entry_point && entry->type == SMBIOS_END_OF_TABLE)
+            break;
+    }
+
+    if ((err = smbios_build_handle_table ()))
+        return err;
+
+    if ((err = smbios_alloc_cooked_cache ()))
+        return err;
+
+    if ((err = smbios_build_map ()))
+        return err;
+
+    if ((err = smbios_make_table_entries (rawdir, offset)))
+        return err;
+
+    return smbios_make_index_entries (smbiosdir, rawdir, cookeddir, keyvaluedir, binarydir);
+}
+
+
+/** \fn static unsigned int dmibios_convert_struct (smbios_struct *struct_ptr, unsigned char *image)
+ *  \brief converts a DMI-BIOS structure to SM-BIOS format
+ *  \param struct_ptr pointer to a DMI-BIOS structure, checked by dmibios_get_struct_length()
+ *  \param image where the SM-BIOS structure is written to
+ *  \return length of the SM-BIOS structure including the strings and the terminating 0x0000
+ *
+ *  A DMI-BIOS structure holds pointers to its strings, they are copied
+ *  behind the formatted area.
+ */
+
+static unsigned int
+dmibios_convert_struct (smbios_struct *struct_ptr, unsigned char *image)
+{
+    unsigned short *stringentry;
+    unsigned int bytestoadd;
+
+
+    /* copy the DMI structure into the image */
+    stringentry = (unsigned short *) ((unsigned char *) struct_ptr + struct_ptr->length);
+    bytestoadd = struct_ptr->length;
+
+    memcpy (image, struct_ptr, bytestoadd);
+
+    if (*stringentry == 0)
+        image[bytestoadd++] = 0;
+
+    while (*stringentry != 0)
+    {
+        unsigned char *string;
+        int stringlen;
+
+        string = (unsigned char *) smbios_base + *stringentry;
+        stringlen = strlen (string) + 1;
+        memcpy (&image[bytestoadd], string, stringlen);
+        bytestoadd += stringlen;
+        stringentry++;
+    }
+
+    image[bytestoadd++] = 0;
+
+    return bytestoadd;
+}
+
+
+/** \fn int dmibios_make_dir_entries (struct proc_dir_entry *smbiosdir,
+ *                  struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir,
+ *                  struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir)
+ *  \brief makes the directory entries for the proc file system
+ *  \param smbiosdir pointer to proc directory where the files should be created in (/proc/smbios)
+ *  \param rawdir pointer to proc directory where the files should be created in (/proc/smbios/raw)
+ *  \param cookeddir pointer to proc directory where the files should be created in (/proc/smbios/cooked)
+ *  \param keyvaluedir pointer to proc directory where the files should be created in (/proc/smbios/keyvalue)
+ *  \param binarydir pointer to proc directory where the files should be created in (/proc/smbios/binary)
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  This function creates the files in the proc file system. Therefore, DMI-BIOS
+ *  is scanned once and every structure is converted to SM-BIOS format. The
+ *  converted structures follow each other in smbios_dmi_images like in a
+ *  SM-BIOS structure table, and the structure index is built from them. So
+ *  the raw and the cooked files of a DMI-BIOS are served like those of a
+ *  SM-BIOS. The files are then created from the index by
+ *  smbios_make_index_entries().
+ *
+ *  \author Thomas Bretthauer
+ *  \date November 2000
+ */
+
+int
+dmibios_make_dir_entries (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir,
+                          struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir)
+{
+    dmibios_table_entry_struct *dmi_table_entry;
+    dmibios_table_entry_struct *dmi_table_end;
+    dmibios_table_entry_struct *dmi_table_limit;
+    smbios_struct *struct_ptr;
+    unsigned int length;
+    unsigned int total = 0;
+    int err;
+
+
+    /* dmi_table_entry is the intermediate table that contains the offsets to the
+     * dmi bios structures. the first pass checks the structures and sums up
+     * the length of their SM-BIOS images. A table without terminator ends
+     * with the F-segment.
+     */
+    dmi_table_limit = (dmibios_table_entry_struct *) ((unsigned char *) smbios_base + BIOS_MAP_LENGTH);
+
+    for (dmi_table_entry = dmibios_entry_point->entry;
+         dmi_table_entry + 1 <= dmi_table_limit && dmi_table_entry->size != 0;
+         dmi_table_entry++)
+    {
+        /* structure = entry point base + offset from intermediate table
+         * struct_ptr contains a pointer to one single dmi bios structure
+         */
+        struct_ptr = smbios_base + dmi_table_entry->handle;
+
+        if (!(length = dmibios_get_struct_length (struct_ptr, BIOS_MAP_LENGTH - dmi_table_entry->handle)))
+        {
+            PDEBUG ("structure at offset %u exceeds the F-segment, table truncated\n", dmi_table_entry->handle);
+            break;
+        }
+
+        if (length > SMBIOS_MAX_STRUCT_LENGTH)
+        {
+            PDEBUG ("structure at offset %u longer than 64 KB, table truncated\n", dmi_table_entry->handle);
+            break;
+        }
+
+        total += length;
+    }
+    dmi_table_end = dmi_table_entry;
+
+    if ((err = smbios_alloc_index (dmi_table_end - dmibios_entry_point->entry)))
+        return err;
+
+    if (!(smbios_dmi_images = vmalloc (total ? total : 1)))
+        return -ENOMEM;
+
+    smbios_index_base = smbios_dmi_images;
+
+    /*
+     * the second pass converts every intermediate structure and records it
+     */
+    for (dmi_table_entry = dmibios_entry_point->entry, total = 0; dmi_table_entry < dmi_table_end; dmi_table_entry++)
+    {
+        struct_ptr = (smbios_struct *) (smbios_dmi_images + total);
+        length = dmibios_convert_struct (smbios_base + dmi_table_entry->handle, (unsigned char *) struct_ptr);
+
+        if (!smbios_index_add (struct_ptr, length))
+            return -ENOMEM;
+
+        total += length;
+    }
+
+    if ((err = smbios_build_handle_table ()))
+        return err;
+
+    if ((err = smbios_alloc_cooked_cache ()))
+        return err;
+
+    return smbios_make_index_entries (smbiosdir, rawdir, cookeddir, keyvaluedir, binarydir);
+}
+
+
+/** \fn int smbios_make_index_entries (struct proc_dir_entry *smbiosdir,
+ *                  struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir,
+ *                  struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir)
+ *  \brief makes the directory entries for every structure in the index
+ *  \param smbiosdir pointer to proc directory where the files should be created in (/proc/smbios)
+ *  \param rawdir pointer to proc directory where the files should be created in (/proc/smbios/raw)
+ *  \param cookeddir pointer to proc directory where the files should be created in (/proc/smbios/cooked)
+ *  \param keyvaluedir pointer to proc directory where the files should be created in (/proc/smbios/keyvalue)
+ *  \param binarydir pointer to proc directory where the files should be created in (/proc/smbios/binary)
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  This function creates the files in the proc file system for the SM-BIOS
+ *  as well as for the DMI-BIOS. It only looks at the index built by
+ *  smbios_make_dir_entries() or dmibios_make_dir_entries(), respectively.
+ *  For every structure a file name will be created with the name of the
+ *  form "type[-subtype].count".
+ */
+
+int
+smbios_make_index_entries (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir,
+                           struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir)
+{
+    unsigned int i;
+    unsigned int raw_name_length = 0;	
+    char raw_name[12];                      /* e.g. 0.0 for structure type 0 , first instance */
+    unsigned int readable_name_length = 0;	
+    char readable_name[64];                 /* e.g. Bios.0 for structure type 0 , first instance */
+    unsigned int instance;
+    unsigned short *instances;
+    smbios_index_entry *entry;
+    smbios_struct *struct_ptr;
+
+
+    /* instance counters, one for every type and one for every subtype of
+     * the types with subtypes. The raw name and the readable name of a
+     * structure both only depend on type and subtype, so one counter
+     * serves all three directories.
+     */
+    if (!(instances = kmalloc (SMBIOS_INSTANCE_COUNTERS * sizeof (unsigned short), GFP_KERNEL)))
+        return -ENOMEM;
+    memset (instances, 0, SMBIOS_INSTANCE_COUNTERS * sizeof (unsigned short));
+
+    for (i = 0; i < smbios_index_count; i++)
+    {
+        entry = &smbios_index[i];
+        struct_ptr = smbios_index_struct (entry);
+        instance = instances[smbios_instance_counter (entry)]++;
+
+        /*
+         *  generate an unique name for the file:  "type[-subtype].count"
+         */
+        if (smbios_type_has_subtype (entry->type))
+        {
+            /* name will contain the raw file name, it equals the structure type (e.g. 1 for Type 1).
+             * readable_name contains the interpreted file name (e.g. System for Type 1)
+             */
+	        raw_name_length = sprintf (raw_name, "%d-%d", entry->type, entry->subtype);
+            readable_name_length = smbios_get_readable_name_ext(readable_name, struct_ptr);
+        }
+        else
+        {
+	        raw_name_length = sprintf (raw_name, "%d", entry->type);
+            readable_name_length = smbios_get_readable_name(readable_name, struct_ptr);
+        }
+
+      
+        /*
+         *  create the file
+         */
+
+        /*
+         * rawname, rawdirectory, index record of the structure, raw mode
+         */
+        make_file_entries (raw_name, rawdir, entry, instance, FILE_MODE_RAW);
+        /*
+         * rawname, cooked directory, index record of the structure, cooked mode
+         */
+        make_file_entries (raw_name, cookeddir, entry, instance, FILE_MODE_COOKED);
+        /*
+         * cookedname, smbiosdirectory, index record of the structure, cooked mode
+         */
+        make_file_entries (readable_name, smbiosdir, entry, instance, FILE_MODE_COOKED);
+        /*
+         * rawname, key=value directory, index record of the structure, key=value mode
+         */
+        make_file_entries (raw_name, keyvaluedir, entry, instance, FILE_MODE_KEYVALUE);
+        /*
+         * rawname, binary directory, index record of the structure, binary mode
+         */
+        make_file_entries (raw_name, binarydir, entry, instance, FILE_MODE_BINARY);
+    }
+
+    kfree (instances);
+
+    return smbios_make_all_entry (smbiosdir, binarydir);
+}
+
+
+/** \fn int smbios_make_all_entry (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *binarydir)
+ *  \brief makes the all files
+ *  \param smbiosdir pointer to proc directory where the file should be created in (/proc/smbios)
+ *  \param binarydir pointer to proc directory where the file should be created in (/proc/smbios/binary)
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The all files hold the cooked text, resp. the binary format, of every
+ *  structure in the order of the table, so a complete inventory is read
+ *  with a single open().
+ */
+
+int
+smbios_make_all_entry (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *binarydir)
+{
+    struct proc_dir_entry *new_entry;
+
+
+    if (!(new_entry = create_proc_entry (PROC_FILE_STRING_ALL, S_IFREG | S_IRUGO, smbiosdir)))
+        return -ENOMEM;
+
+    new_entry->proc_fops = &smbios_all_fops;
+
+    if (!(new_entry = create_proc_entry (PROC_FILE_STRING_ALL, S_IFREG | S_IRUGO, binarydir)))
+        return -ENOMEM;
+
+    new_entry->proc_fops = &smbios_binary_all_fops;
+
+    return 0;
+}
+
+
+/** \fn int smbios_make_stats_entry (struct proc_dir_entry *smbiosdir)
+ *  \brief makes the stats file
+ *  \param smbiosdir pointer to proc directory where the file should be created in (/proc/smbios)
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The stats file shows how often files were opened, how many buffers
+ *  were taken from the slab caches and how many outputs were rendered,
+ *  see smbios_stats.
+ */
+
+int
+smbios_make_stats_entry (struct proc_dir_entry *smbiosdir)
+{
+    struct proc_dir_entry *new_entry;
+
+
+    if (!(new_entry = create_proc_entry (PROC_FILE_STRING_STATS, S_IFREG | S_IRUGO, smbiosdir)))
+        return -ENOMEM;
+
+    new_entry->proc_fops = &smbios_stats_fops;
+
+    return 0;
+}
+
+
+/** \fn int smbios_create_caches (void)
+ *  \brief creates the slab cache of the buffers of open files
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  Every open file has a smbios_file_buffer, it is taken from a cache of
+ *  its own instead of kmalloc().
+ */
+
+int
+smbios_create_caches (void)
+{
+    if (!(smbios_buffer_cache = kmem_cache_create ("smbios_buffer", sizeof (smbios_file_buffer), 0, 0, NULL, NULL)))
+        return -ENOMEM;
+
+    return 0;
+}
+
+
+/** \fn void smbios_destroy_caches (void)
+ *  \brief destroys the slab cache of the buffers of open files
+ *
+ *  No file may be open when the caches are destroyed.
+ */
+
+void
+smbios_destroy_caches (void)
+{
+    if (smbios_buffer_cache)
+        kmem_cache_destroy (smbios_buffer_cache);
+
+    smbios_buffer_cache = 0;
+}
+
+
+/** \fn int smbios_alloc_cooked_cache (void)
+ *  \brief allocates an empty cooked text record for every structure in the index
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  Like the index, the records are taken from vmalloc(), kmalloc() stops
+ *  at 128 KB.
+ */
+
+int
+smbios_alloc_cooked_cache (void)
+{
+    unsigned int size = smbios_index_count * sizeof (smbios_cooked_entry);
+
+
+    if (!(smbios_cooked_cache = vmalloc (size ? size : 1)))
+        return -ENOMEM;
+
+    memset (smbios_cooked_cache, 0, size);
+
+    return 0;
+}
+
+
+/** \fn void smbios_free_cooked_cache (void)
+ *  \brief frees the cooked text of all structures and the binary format of all structures
+ */
+
+void
+smbios_free_cooked_cache (void)
+{
+    unsigned int i;
+
+
+    if (!smbios_cooked_cache)
+        return;
+
+    for (i = 0; i < smbios_index_count; i++)
+    {
+        if (smbios_cooked_cache[i].decoded)
+            kfree (smbios_cooked_cache[i].decoded);
+        if (smbios_cooked_cache[i].text)
+            kfree (smbios_cooked_cache[i].text);
+        if (smbios_cooked_cache[i].keyvalue)
+            kfree (smbios_cooked_cache[i].keyvalue);
+        if (smbios_cooked_cache[i].binary)
+            kfree (smbios_cooked_cache[i].binary);
+    }
+
+    vfree (smbios_cooked_cache);
+    smbios_cooked_cache = 0;
+
+    if (smbios_binary_all)
+        vfree (smbios_binary_all);
+
+    smbios_binary_all = 0;
+    smbios_binary_all_length = 0;
+}
+
+
+/** \fn static smbios_decoded * smbios_get_decoded (smbios_cooked_entry *cooked, smbios_index_entry *entry)
+ *  \brief returns the decoded structure
+ *  \param cooked cache record of the structure
+ *  \param entry index record of the structure
+ *  \return pointer to the decoded structure, NULL if not enough memory
+ *
+ *  The structure is decoded by bios_decode() on the first call only, all
+ *  outputs are rendered from the same decoded structure. The caller must
+ *  hold smbios_cooked_lock.
+ */
+
+static smbios_decoded *
+smbios_get_decoded (smbios_cooked_entry *cooked, smbios_index_entry *entry)
+{
+    if (!cooked->decoded)
+        cooked->decoded = bios_decode (smbios_index_struct (entry));
+
+    return cooked->decoded;
+}
+
+
+/** \fn int smbios_get_cooked (smbios_index_entry *entry, unsigned char **ptext, unsigned int *plength)
+ *  \brief returns the cooked text of a structure
+ *  \param entry index record of the structure
+ *  \param ptext [OUT]-Param. pointer to the text
+ *  \param plength [OUT]-Param. length of the text
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The decoded structure is rendered by bios_cook() on the first call
+ *  only, later calls return the same text. The text belongs to the cache, the caller
+ *  must not free it. Once the length is known it is set as the size of
+ *  the cooked files of the structure.
+ */
+
+int
+smbios_get_cooked (smbios_index_entry *entry, unsigned char **ptext, unsigned int *plength)
+{
+    smbios_cooked_entry *cooked = &smbios_cooked_cache[entry - smbios_index];
+    smbios_decoded *decoded;
+    unsigned int i;
+
+
+    if (down_interruptible (&smbios_cooked_lock))
+        return -ERESTARTSYS;
+
+    if (cooked->text)
+        atomic_inc (&smbios_statistics.cache_hits);
+    else if ((decoded = smbios_get_decoded (cooked, entry)))
+    {
+        cooked->text = bios_cook (decoded, &cooked->length);
+
+        if (cooked->text)
+        {
+            atomic_inc (&smbios_statistics.renders);
+            for (i = 0; i < cooked->no_of_files; i++)
+                cooked->file[i]->size = cooked->length;
+        }
+    }
+
+    up (&smbios_cooked_lock);
+
+    *ptext = cooked->text;
+    *plength = cooked->length;
+
+    return cooked->text ? 0 : -ENOMEM;
+}
+
+
+/** \fn int smbios_get_keyvalue (smbios_index_entry *entry, unsigned char **ptext, unsigned int *plength)
+ *  \brief returns the cooked text of a structure as key=value lines
+ *  \param entry index record of the structure
+ *  \param ptext [OUT]-Param. pointer to the text
+ *  \param plength [OUT]-Param. length of the text
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The decoded structure is rendered by bios_cook_keyvalue() on the first
+ *  call only and kept in the cache, just like the cooked text.
+ */
+
+int
+smbios_get_keyvalue (smbios_index_entry *entry, unsigned char **ptext, unsigned int *plength)
+{
+    smbios_cooked_entry *cooked = &smbios_cooked_cache[entry - smbios_index];
+    smbios_decoded *decoded;
+
+
+    if (down_interruptible (&smbios_cooked_lock))
+        return -ERESTARTSYS;
+
+    if (cooked->keyvalue)
+        atomic_inc (&smbios_statistics.cache_hits);
+    else if ((decoded = smbios_get_decoded (cooked, entry)))
+    {
+        cooked->keyvalue = bios_cook_keyvalue (decoded, &cooked->keyvalue_length);
+
+        if (cooked->keyvalue)
+            atomic_inc (&smbios_statistics.renders);
+        if (cooked->keyvalue && cooked->keyvalue_file)
+            cooked->keyvalue_file->size = cooked->keyvalue_length;
+    }
+
+    up (&smbios_cooked_lock);
+
+    *ptext = cooked->keyvalue;
+    *plength = cooked->keyvalue_length;
+
+    return cooked->keyvalue ? 0 : -ENOMEM;
+}
+
+
+/** \fn int smbios_get_binary (smbios_index_entry *entry, unsigned char **pdata, unsigned int *plength)
+ *  \brief returns a structure in the binary format
+ *  \param entry index record of the structure
+ *  \param pdata [OUT]-Param. pointer to the structure in the binary format
+ *  \param plength [OUT]-Param. length of the structure in the binary format
+ *  \return -ERESTARTSYS if interrupted, -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The decoded structure is rendered by bios_cook_binary() on the first
+ *  call only and kept in the cache, just like the cooked text.
+ */
+
+int
+smbios_get_binary (smbios_index_entry *entry, unsigned char **pdata, unsigned int *plength)
+{
+    smbios_cooked_entry *cooked = &smbios_cooked_cache[entry - smbios_index];
+    smbios_decoded *decoded;
+
+
+    if (down_interruptible (&smbios_cooked_lock))
+        return -ERESTARTSYS;
+
+    if (cooked->binary)
+        atomic_inc (&smbios_statistics.cache_hits);
+    else if ((decoded = smbios_get_decoded (cooked, entry)))
+    {
+        cooked->binary = bios_cook_binary (decoded, &cooked->binary_length);
+
+        if (cooked->binary)
+            atomic_inc (&smbios_statistics.renders);
+        if (cooked->binary && cooked->binary_file)
+            cooked->binary_file->size = cooked->binary_length;
+    }
+
+    up (&smbios_cooked_lock);
+
+    *pdata = cooked->binary;
+    *plength = cooked->binary_length;
+
+    return cooked->binary ? 0 : -ENOMEM;
+}
+
+
+/** \fn unsigned int smbios_instance_counter (smbios_index_entry *entry)
+ *  \brief returns the number of the instance counter for a structure
+ *  \param entry index record of the structure
+ *  \return number of the counter, less than SMBIOS_INSTANCE_COUNTERS
+ *
+ *  Counters 0 to 255 count the structures of the types without subtypes.
+ *  Every type with subtypes has another 256 counters, one per subtype,
+ *  in the order of smbios_types_with_subtypes.
+ */
+
+unsigned int
+smbios_instance_counter (smbios_index_entry *entry)
+{
+    unsigned int i;
+
+
+    for (i = 0; i < sizeof (smbios_types_with_subtypes); i++)
+        if (entry->type == smbios_types_with_subtypes[i])
+            return 256 * (i + 1) + entry->subtype;
+
+    return entry->type;
+}
+
+
+/** \fn int smbios_alloc_index (unsigned int count)
+ *  \brief allocates the structure index
+ *  \param count number of structures expected
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  Allocates room for count index records. count is only a hint,
+ *  smbios_index_add() grows the index if the table holds more structures.
+ *  The index and the string records are taken from vmalloc(), kmalloc()
+ *  stops at 128 KB, which is a few thousand structures.
+ */
+
+int
+smbios_alloc_index (unsigned int count)
+{
+    smbios_free_index ();
+
+    if (count == 0)
+        count = 1;
+
+    if (!(smbios_index = vmalloc (count * sizeof (smbios_index_entry))))
+        return -ENOMEM;
+
+    smbios_index_size = count;
+
+    /* most structures have less than four strings */
+    if (!(smbios_string_refs = vmalloc (4 * count * sizeof (smbios_string_ref))))
+        return -ENOMEM;
+
+    smbios_string_size = 4 * count;
+
+    return 0;
+}
 
-        /*
-         * rawname, rawdirectory, pointer to dmibios structure, raw mode
-         */
-        make_file_entries (raw_name, rawdir, struct_ptr, FILE_MODE_RAW);
-        /*
-         * rawname, cooked directory, pointer to dmibios structure, cooked mode
-         */
-        make_file_entries (raw_name, cookeddir, struct_ptr, FILE_MODE_COOKED);
-        /*
-         * cookedname, smbiosdirectory, pointer to dmibios structure, cooked mode
-         */
-        make_file_entries (readable_name, smbiosdir, struct_ptr, FILE_MODE_COOKED);
 
-        /*
-         *  go to the next structure
-         */
-        struct_ptr =
-	       (smbios_struct *) ((unsigned char *) struct_ptr + smbios_get_struct_length(struct_ptr));
+/** \fn void smbios_free_index (void)
+ *  \brief frees the structure index
+ *
+ *  The handle lookup table, the cooked text, the map and the converted
+ *  DMI-BIOS structures are freed as well.
+ *  No file of the proc file system may refer to the index when it is freed.
+ */
+
+void
+smbios_free_index (void)
+{
+    smbios_free_map ();
+    smbios_free_cooked_cache ();
+
+    if (smbios_handle_table)
+        vfree (smbios_handle_table);
+
+    smbios_handle_table = 0;
+    smbios_handle_mask = 0;
+
+    if (smbios_index)
+        vfree (smbios_index);
+
+    smbios_index = 0;
+    smbios_index_count = 0;
+    smbios_index_size = 0;
+
+    if (smbios_string_refs)
+        vfree (smbios_string_refs);
+
+    smbios_string_refs = 0;
+    smbios_string_count = 0;
+    smbios_string_size = 0;
+
+    if (smbios_dmi_images)
+        vfree (smbios_dmi_images);
+
+    smbios_dmi_images = 0;
+}
+
+
+/** \fn static int smbios_string_add (unsigned char *string, unsigned int length)
+ *  \brief appends a string to smbios_string_refs
+ *  \param string pointer to the string, must lie behind smbios_index_base
+ *  \param length length of the string without the terminating 0x00
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ */
+
+static int
+smbios_string_add (unsigned char *string, unsigned int length)
+{
+    smbios_string_ref *ref;
+
+
+    /* grow the string records if needed */
+    if (smbios_string_count == smbios_string_size)
+    {
+        smbios_string_ref *new_refs;
+
+        if (!(new_refs = vmalloc (2 * smbios_string_size * sizeof (smbios_string_ref))))
+            return -ENOMEM;
+
+        memcpy (new_refs, smbios_string_refs, smbios_string_count * sizeof (smbios_string_ref));
+        vfree (smbios_string_refs);
+
+        smbios_string_refs = new_refs;
+        smbios_string_size *= 2;
     }
 
+    ref = &smbios_string_refs[smbios_string_count++];
+
+    ref->offset = string - (unsigned char *) smbios_index_base;
+    ref->length = length;
+
     return 0;
 }
 
 
-/** \fn int dmibios_make_dir_entries (struct proc_dir_entry *smbiosdir,
- *                  struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir)
- *  \brief makes the directory entries for the proc file system
- *  \param smbiosdir pointer to proc directory where the files should be created in (/proc/smbios)
- *  \param rawdir pointer to proc directory where the files should be created in (/proc/smbios/raw)
- *  \param cookeddir pointer to proc directory where the files should be created in (/proc/smbios/cooked)
+/** \fn static int smbios_index_strings (smbios_index_entry *entry)
+ *  \brief records the strings of a structure
+ *  \param entry index record of the structure, its length must be set
  *  \return -ENOMEM if not enough memory, 0 otherwise
  *
- *  This function creates the files in the proc file system. Therefore, DMI-BIOS
- *  is scanned and for every type found a file name will be created with the
- *  name of the form "type[-subtype].count".
+ *  A SM-BIOS structure is followed by its strings, DMI-BIOS structures
+ *  are converted to SM-BIOS format before they are recorded. GetString()
+ *  then finds a string without walking the strings in front of it.
+ */
+
+static int
+smbios_index_strings (smbios_index_entry *entry)
+{
+    unsigned char *struct_ptr = (unsigned char *) smbios_index_struct (entry);
+    unsigned int offset;
+    unsigned int length;
+
+
+    entry->strings = smbios_string_count;
+    entry->string_count = 0;
+
+    /* the string area ends with a double 0x00, the length bounds the walk */
+    for (offset = entry->formatted_length;
+         offset < entry->length && struct_ptr[offset] != 0 && entry->string_count < SMBIOS_MAX_STRINGS;
+         offset += length + 1)
+    {
+        length = strnlen (&struct_ptr[offset], entry->length - offset);
+
+        if (smbios_string_add (&struct_ptr[offset], length))
+            return -ENOMEM;
+
+        entry->string_count++;
+    }
+
+    return 0;
+}
+
+
+/** \fn smbios_index_entry * smbios_index_add (smbios_struct *struct_ptr, unsigned int length)
+ *  \brief appends a structure to the structure index
+ *  \param struct_ptr pointer to the structure, must lie behind smbios_index_base
+ *  \param length length of the structure including the strings
+ *  \return pointer to the new index record, NULL if not enough memory
  *
- *  \author Thomas Bretthauer
- *  \date November 2000
+ *  The returned pointer is only valid until the next call, since the index
+ *  may be moved when it grows. Files must not be created before the index
+ *  is complete.
+ */
+
+smbios_index_entry *
+smbios_index_add (smbios_struct *struct_ptr, unsigned int length)
+{
+    smbios_index_entry *entry;
+
+
+    /* grow the index if needed */
+    if (smbios_index_count == smbios_index_size)
+    {
+        smbios_index_entry *new_index;
+
+        if (!(new_index = vmalloc (2 * smbios_index_size * sizeof (smbios_index_entry))))
+            return NULL;
+
+        memcpy (new_index, smbios_index, smbios_index_count * sizeof (smbios_index_entry));
+        vfree (smbios_index);
+
+        smbios_index = new_index;
+        smbios_index_size *= 2;
+    }
+
+    entry = &smbios_index[smbios_index_count++];
+
+    entry->offset = (unsigned char *) struct_ptr - (unsigned char *) smbios_index_base;
+    entry->length = length;
+    entry->handle = struct_ptr->handle;
+    entry->type = struct_ptr->type;
+    entry->subtype = smbios_type_has_subtype (struct_ptr->type) ? struct_ptr->subtype : 0;
+    entry->formatted_length = struct_ptr->length;
+
+    if (smbios_index_strings (entry))
+    {
+        smbios_index_count--;
+        return NULL;
+    }
+
+    return entry;
+}
+
+
+/** \fn smbios_struct * smbios_index_struct (smbios_index_entry *entry)
+ *  \brief returns the structure an index record refers to
+ *  \param entry index record
+ *  \return pointer to the raw SM-BIOS, resp. DMI-BIOS structure
+ */
+
+smbios_struct *
+smbios_index_struct (smbios_index_entry *entry)
+{
+    return (smbios_struct *) ((unsigned char *) smbios_index_base + entry->offset);
+}
+
+
+/** \fn smbios_index_entry * smbios_find_struct (smbios_struct *struct_ptr)
+ *  \brief returns the index record of a structure
+ *  \param struct_ptr pointer to the raw SM-BIOS, resp. DMI-BIOS structure
+ *  \return index record of the structure, NULL if the structure is not in the index
+ *
+ *  The structure is looked up by its handle. NULL is returned for a
+ *  structure whose handle is used by another structure as well.
+ */
+
+smbios_index_entry *
+smbios_find_struct (smbios_struct *struct_ptr)
+{
+    smbios_index_entry *entry;
+
+
+    if (!(entry = smbios_find_handle (struct_ptr->handle)))
+        return NULL;
+
+    if (smbios_index_struct (entry) != struct_ptr)
+        return NULL;
+
+    return entry;
+}
+
+
+/** \fn int smbios_build_map (void)
+ *  \brief builds the image of the map file
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The image is a smbios_map_header followed by the structure index, the
+ *  string records and a copy of the structure table. It is built from
+ *  whole pages, so it can be mapped into user space, and does not change
+ *  until the module is unloaded. Only SM-BIOS has a table to map.
  */
 
 int
-dmibios_make_dir_entries (struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir)
+smbios_build_map (void)
 {
-    dmibios_table_entry_struct *dmi_table_entry;
-    smbios_struct *struct_ptr;
-    unsigned int raw_name_length = 0;	
-    char raw_name[12];                      /* e.g. 0.0 for structure type 0 , first instance */
-    unsigned int readable_name_length = 0;	
-    char readable_name[64];                 /* e.g. Bios.0 for structure type 0 , first instance */
+    smbios_map_header *header;
+    unsigned int length;
+    unsigned long page;
 
 
-    /* dmi_table_entry is the intermediate table that contains the offsets to the
-     * dmi bios structures.
-     */
-    dmi_table_entry = dmibios_entry_point->entry;
+    length = sizeof (smbios_map_header);
+    length += smbios_index_count * sizeof (smbios_index_entry);
+    length += smbios_string_count * sizeof (smbios_string_ref);
+    length = (length + 15) & ~15;	/* the table starts on a paragraph */
+    length += smbios_table_length;
 
-    /*
-     * for every intermediate structure do ...
-     */
-    while (dmi_table_entry->size != 0)
+    smbios_map_order = get_order (length);
+
+    if (!(smbios_map = (unsigned char *) __get_free_pages (GFP_KERNEL, smbios_map_order)))
+        return -ENOMEM;
+
+    smbios_map_length = length;
+    memset (smbios_map, 0, PAGE_SIZE << smbios_map_order);
+
+    /* the pages are mapped by remap_page_range(), which needs them reserved */
+    for (page = (unsigned long) smbios_map;
+         page < (unsigned long) smbios_map + (PAGE_SIZE << smbios_map_order);
+         page += PAGE_SIZE)
+        mem_map_reserve (virt_to_page (page));
+
+    header = (smbios_map_header *) smbios_map;
+    header->magic = SMBIOS_MAP_MAGIC;
+    header->header_length = sizeof (smbios_map_header);
+    header->index_entry_length = sizeof (smbios_index_entry);
+    header->index_offset = sizeof (smbios_map_header);
+    header->index_count = smbios_index_count;
+    header->strings_offset = header->index_offset + smbios_index_count * sizeof (smbios_index_entry);
+    header->strings_count = smbios_string_count;
+    header->table_offset = (header->strings_offset + smbios_string_count * sizeof (smbios_string_ref) + 15) & ~15;
+    header->table_length = smbios_table_length;
+
+    memcpy (smbios_map + header->index_offset, smbios_index, smbios_index_count * sizeof (smbios_index_entry));
+    memcpy (smbios_map + header->strings_offset, smbios_string_refs, smbios_string_count * sizeof (smbios_string_ref));
+
+    if (smbios_snapshot_taken)
+        memcpy (smbios_map + header->table_offset, smbios_structures_base, smbios_table_length);
+    else
+        memcpy_fromio (smbios_map + header->table_offset, smbios_structures_base, smbios_table_length);
+
+    return 0;
+}
+
+
+/** \fn void smbios_free_map (void)
+ *  \brief frees the image of the map file
+ *
+ *  No file of the proc file system may refer to the map when it is freed.
+ */
+
+void
+smbios_free_map (void)
+{
+    unsigned long page;
+
+
+    if (!smbios_map)
+        return;
+
+    for (page = (unsigned long) smbios_map;
+         page < (unsigned long) smbios_map + (PAGE_SIZE << smbios_map_order);
+         page += PAGE_SIZE)
+        mem_map_unreserve (virt_to_page (page));
+
+    free_pages ((unsigned long) smbios_map, smbios_map_order);
+
+    smbios_map = 0;
+    smbios_map_length = 0;
+    smbios_map_order = 0;
+}
+
+
+/** \fn int smbios_build_handle_table (void)
+ *  \brief builds the handle lookup table from the structure index
+ *  \return -ENOMEM if not enough memory, 0 otherwise
+ *
+ *  The table is an open addressing hash table with linear probing. It has
+ *  at least twice as many slots as there are structures, so a lookup
+ *  rarely needs more than one probe. If the BIOS reports a handle more
+ *  than once, the first structure with this handle is found. Like the
+ *  index, the table is taken from vmalloc().
+ */
+
+int
+smbios_build_handle_table (void)
+{
+    unsigned int size;
+    unsigned int slot;
+    unsigned int i;
+
+
+    for (size = 16; size < 2 * smbios_index_count; size <<= 1)
+        ;
+
+    if (!(smbios_handle_table = vmalloc (size * sizeof (__u32))))
+        return -ENOMEM;
+
+    memset (smbios_handle_table, 0xFF, size * sizeof (__u32));
+    smbios_handle_mask = size - 1;
+
+    for (i = 0; i < smbios_index_count; i++)
     {
-        /* structure = entry point base + offset from intermediate table
-         * struct_ptr contains a pointer to one single dmi bios structure
+        /* multiplying by an odd constant spreads sparse DMI-BIOS handles
+         * and still maps consecutive handles to distinct slots
          */
-        struct_ptr = smbios_base + dmi_table_entry->handle;
+        slot = (smbios_index[i].handle * 0x9E37U) & smbios_handle_mask;
 
-        /*
-         * generate a unique name for the file:  "type[-subtype].count"
-         */
-        if (smbios_type_has_subtype (((smbios_struct *) struct_ptr)->type))
-	    {
-            /* name will contain the raw file name, it equals the structure type (e.g. 1 for Type 1).
-             * readable_name contains the interpreted file name (e.g. System for Type 1)
-             */
-            raw_name_length = sprintf (raw_name, "%d-%d", struct_ptr->type, struct_ptr->subtype);
-            readable_name_length = smbios_get_readable_name_ext(readable_name, struct_ptr);
-        }
+        while (smbios_handle_table[slot] != SMBIOS_HANDLE_EMPTY &&
+               smbios_index[smbios_handle_table[slot]].handle != smbios_index[i].handle)
+            slot = (slot + 1) & smbios_handle_mask;
+
+        if (smbios_handle_table[slot] == SMBIOS_HANDLE_EMPTY)
+            smbios_handle_table[slot] = i;
         else
-        {
-	        raw_name_length = sprintf (raw_name, "%d", struct_ptr->type);
-            readable_name_length = smbios_get_readable_name(readable_name, struct_ptr);
-        }
+            PDEBUG ("duplicate handle %d ignored\n", smbios_index[i].handle);
+    }
 
-    
-        /*
-         * create the files
-         */
+    return 0;
+}
 
-        /*
-         * rawname, rawdirectory, pointer to dmibios structure, raw mode
-         */
-        make_file_entries (raw_name, rawdir, struct_ptr, FILE_MODE_RAW);
-        /*
-         * rawname, cooked directory, pointer to dmibios structure, cooked mode
-         */
-        make_file_entries (raw_name, cookeddir, struct_ptr, FILE_MODE_COOKED);
-        /*
-         * cookedname, smbiosdirectory, pointer to dmibios structure, cooked mode
-         */
-        make_file_entries (readable_name, smbiosdir, struct_ptr, FILE_MODE_COOKED);
 
-      
-        /*
-         * go to the next structure
-         */
-        dmi_table_entry++;
+/** \fn smbios_index_entry * smbios_find_handle (__u16 handle)
+ *  \brief looks up a structure by its handle
+ *  \param handle handle of the structure, e.g. a cache handle of a processor structure
+ *  \return index record of the structure, NULL if there is no structure with this handle
+ *
+ *  Use smbios_index_struct() to get the structure itself.
+ */
+
+smbios_index_entry *
+smbios_find_handle (__u16 handle)
+{
+    unsigned int slot;
+
+
+    if (!smbios_handle_table)
+        return NULL;
+
+    for (slot = (handle * 0x9E37U) & smbios_handle_mask;
+         smbios_handle_table[slot] != SMBIOS_HANDLE_EMPTY;
+         slot = (slot + 1) & smbios_handle_mask)
+    {
+        if (smbios_index[smbios_handle_table[slot]].handle == handle)
+            return &smbios_index[smbios_handle_table[slot]];
+    }
+
+    return NULL;
+}
+
+
+/** \fn int smbios_snapshot (void)
+ *  \brief copies the entry point and the structure table into kernel memory
+ *  \return -ENOMEM if not enough memory, -ENXIO if a checksum of the copy is wrong, 0 otherwise
+ *
+ *  The F-segment and the structure table are mapped with ioremap(), which
+ *  often gives uncached memory. Reading every structure from there is slow,
+ *  so this function takes a copy in normal memory and releases the
+ *  mappings. Afterwards smbios_entry_point, smbios_structures_base,
+ *  dmibios_entry_point and smbios_base refer to the copy.
+ *
+ *  For SM-BIOS (2.x and 3.0) only the entry point and the structure table are copied.
+ *  The DMI-BIOS structures and strings are spread over the F-segment, so
+ *  the whole segment is copied.
+ *
+ *  If the function fails, the mappings are left untouched.
+ */
+
+int
+smbios_snapshot (void)
+{
+    void *entry_point;
+    void *entry_point_source;
+    unsigned char *table;
+    unsigned int length;
+    unsigned int entry_point_length;
+
+
+    if (dmibios_entry_point)
+    {
+        if (!(table = vmalloc (BIOS_MAP_LENGTH)))
+            return -ENOMEM;
+
+        memcpy_fromio (table, smbios_base, BIOS_MAP_LENGTH);
+
+        dmibios_entry_point = (dmibios_entry_point_struct *)
+            (table + ((unsigned char *) dmibios_entry_point - (unsigned char *) smbios_base));
+        smbios_structures_base = dmibios_entry_point->entry;
+
+        iounmap (smbios_base);
+        smbios_base = table;
+        smbios_snapshot_taken = 1;
+
+        PDEBUG ("DMI-BIOS F-segment copied to 0x%p\n", smbios_base);
+
+        return 0;
+    }
+
+    length = smbios_table_length;
+
+    /* the checksum covers entry_point_length bytes, which may be more than we know of */
+    if (smbios3_entry_point)
+    {
+        entry_point_source = smbios3_entry_point;
+        entry_point_length = smbios3_entry_point->entry_point_length;
+        if (entry_point_length < sizeof (smbios3_entry_point_struct))
+            entry_point_length = sizeof (smbios3_entry_point_struct);
+    }
+    else
+    {
+        entry_point_source = smbios_entry_point;
+        entry_point_length = smbios_entry_point->entry_point_length;
+        if (entry_point_length < sizeof (smbios_entry_point_struct))
+            entry_point_length = sizeof (smbios_entry_point_struct);
+    }
+
+    if (!(entry_point = kmalloc (entry_point_length, GFP_KERNEL)))
+        return -ENOMEM;
+
+    if (!(table = vmalloc (length ? length : 1)))
+    {
+        kfree (entry_point);
+        return -ENOMEM;
+    }
+
+    memcpy_fromio (entry_point, entry_point_source, entry_point_length);
+    memcpy_fromio (table, smbios_structures_base, length);
+
+    /* the entry point and the intermediate entry point must add up to 0 */
+    if (smbios3_entry_point ? smbios3_check_entry_point (entry_point) :
+        (smbios_check_entry_point (entry_point) || smbios_check_intermediate_entry_point (entry_point)))
+    {
+        PDEBUG ("checksum of the entry point copy is wrong\n");
+        vfree (table);
+        kfree (entry_point);
+        return -ENXIO;
     }
 
+#ifdef _DEBUG_
+    smbios_bench_reads (smbios_structures_base, table, length);
+#endif
+
+    iounmap (smbios_structures_base);
+    iounmap (smbios_base);
+
+    smbios_base = 0;
+    if (smbios3_entry_point)
+        smbios3_entry_point = entry_point;
+    else
+        smbios_entry_point = entry_point;
+    smbios_structures_base = table;
+    smbios_snapshot_taken = 1;
+
+    PDEBUG ("SM-BIOS structure table copied to 0x%p\n", smbios_structures_base);
+
     return 0;
 }
 
 
+/** \fn void smbios_release_structures (void)
+ *  \brief releases the SM-BIOS structure table
+ *
+ *  Unmaps the structure table or frees its copy, respectively. Nothing
+ *  has to be done for DMI-BIOS, its structures are part of the F-segment.
+ */
+
+void
+smbios_release_structures (void)
+{
+    if (dmibios_entry_point || !smbios_structures_base)
+        return;
+
+    if (smbios_snapshot_taken)
+        vfree (smbios_structures_base);
+    else
+        iounmap (smbios_structures_base);
+
+    smbios_structures_base = 0;
+}
+
+
+/** \fn void smbios_release_base (void)
+ *  \brief releases the F-segment
+ *
+ *  Unmaps the F-segment or frees the copies taken by smbios_snapshot(),
+ *  respectively.
+ */
+
+void
+smbios_release_base (void)
+{
+    if (smbios_snapshot_taken)
+    {
+        if (smbios_entry_point)
+            kfree (smbios_entry_point);
+        if (smbios3_entry_point)
+            kfree (smbios3_entry_point);
+        if (smbios_base)
+            vfree (smbios_base);
+    }
+    else if (smbios_base)
+        iounmap (smbios_base);
+
+    smbios_base = 0;
+    smbios_entry_point = 0;
+    smbios3_entry_point = 0;
+    dmibios_entry_point = 0;
+}
+
+
 /** \fn void smbios_destroy_dir_entries (struct proc_dir_entry *dir)
  *  \brief destroys the created files in the given proc directory
  *  \param dir directory of the files to be deleted
@@ -924,12 +2545,14 @@ smbios_get_readable_name(char *name, smbios_struct *struct_ptr)
 }
 
 
-/** \fn int make_file_entries (char *filename, struct proc_dir_entry *dir, smbios_struct *struct_ptr, int mode)
+/** \fn int make_file_entries (char *filename, struct proc_dir_entry *dir, smbios_index_entry *entry,
+ *                                unsigned int instance, int mode)
  *  \brief creates a file in a given /proc directory
  *  \param filename name of the file to create
  *  \param dir /proc directory where the file should be created
- *  \param struct_ptr the raw smbios structure related to the filename
- *  \param mode indicates if we need the cooked or the raw mode
+ *  \param entry index record of the raw smbios structure related to the filename
+ *  \param instance instance number of the structure, appended to the filename
+ *  \param mode indicates if we need the raw, cooked, key=value or binary mode
  *
  *  creates a file in a given /proc directory
  *
@@ -938,50 +2561,64 @@ smbios_get_readable_name(char *name, smbios_struct *struct_ptr)
  */
 
 int
-make_file_entries (char *filename, struct proc_dir_entry *dir, smbios_struct *struct_ptr, int mode)
+make_file_entries (char *filename, struct proc_dir_entry *dir, smbios_index_entry *entry,
+                   unsigned int instance, int mode)
 {
     struct proc_dir_entry *new_entry;
-    struct proc_dir_entry *entry_ptr;
-    int count;
 		char local_filename[64];
 
 
-	strcpy(local_filename, filename);
-
-    /* look for the number of file entries with the above name. if we find to instances
-     * we have now a third instance. count contains the new instance number
-     */
-    count = 0;
-    for (entry_ptr = dir->subdir; entry_ptr; entry_ptr = entry_ptr->next)
-	    if (!(strncmp (local_filename, entry_ptr->name, strlen(local_filename))))
-	        count++;
-    
     /*
      * name contains now <rawname>.<instance> (e.g. 1.1 for the second instance of Type 1 structure)
      * the same is valid for readable_name. it contains the readable name and instance for our structure.
      * <readable_name>.<instance> (e.g. System.1)
      * this will be the file names for the /proc file system.
      */
-    sprintf (local_filename + strlen(local_filename), ".%d", count);
+    sprintf (local_filename, "%s.%d", filename, instance);
     PDEBUG("About to create file name: %s ...\n", local_filename);
 	
     if (!(new_entry = create_proc_entry (local_filename, S_IFREG | S_IRUGO, dir)))
         return -ENOMEM;
 
-    /* set data pointer to the raw smbios structure */
-    new_entry->data = struct_ptr;
+    /* set data pointer to the index record of the raw smbios structure */
+    new_entry->data = entry;
 
-    /* set the read function for this file */
+    /* set the file operations for this file */
     if(mode == FILE_MODE_RAW)
     {
-        new_entry->read_proc = bios_read_raw_proc;
-        new_entry->size=smbios_get_struct_length(struct_ptr);
+        new_entry->proc_fops = &smbios_raw_fops;
+        new_entry->size = entry->length;
+    }
+
+    else if (mode == FILE_MODE_BINARY)
+    {
+        new_entry->proc_fops = &smbios_binary_fops;
+        /* the size is not known before the structure is converted */
+        new_entry->size = 0;
+
+        smbios_cooked_cache[entry - smbios_index].binary_file = new_entry;
+    }
+
+    else if (mode == FILE_MODE_KEYVALUE)
+    {
+        new_entry->proc_fops = &smbios_keyvalue_fops;
+        /* the size is not known before the structure is cooked */
+        new_entry->size = 0;
+
+        smbios_cooked_cache[entry - smbios_index].keyvalue_file = new_entry;
     }
 
     else 
     {
-        new_entry->read_proc = bios_read_cooked_proc;
+        smbios_cooked_entry *cooked = &smbios_cooked_cache[entry - smbios_index];
+
+        new_entry->proc_fops = &smbios_cooked_fops;
+        /* the size is not known before the structure is cooked */
         new_entry->size = 0;
+
+        /* remember the file to set its size once the structure is cooked */
+        if (cooked->no_of_files < COOKED_FILES_PER_STRUCT)
+            cooked->file[cooked->no_of_files++] = new_entry;
     }
 
     return 0;
@@ -62,21 +62,57 @@
 #define BIOS_START_ADDRESS      0xF0000
 /** length of the scanned BIOS area for SM-BIOS and DMI-BIOS */
 #define BIOS_MAP_LENGTH         0x10000
+/** length mapped at an entry point address given by the firmware, fits
+ * the SM-BIOS as well as the SM-BIOS 3.0 entry point */
+#define ENTRY_POINT_MAP_LENGTH  0x20
 /** magic 4 bytes to identify SM-BIOS entry point, paragraph boundary */
 #define SMBIOS_MAGIC_DWORD      0x5F4D535F /* anchor string "_SM_" */
+/** magic 4 bytes to identify SM-BIOS 3.0 (64 bit) entry point, paragraph boundary */
+#define SMBIOS3_MAGIC_DWORD     0x334D535F /* anchor string "_SM3", followed by '_' */
 /** magic 4 bytes to identify DMI-BIOS entry point, byte boundary */
 #define DMIBIOS_MAGIC_DWORD     0x494d445f /* anchor string "_DMI" */
+/** bytes behind a DMI-BIOS anchor that must be within the scanned area */
+#define DMIBIOS_SCAN_RESERVE    (10 + 32)
 /** identifier for SM-BIOS structures within SM-BIOS entry point */
 #define DMI_STRING              "_DMI_"
+/** length of the header every structure starts with (type, length, handle) */
+#define SMBIOS_HEADER_LENGTH    4
+/** type of the end-of-table structure */
+#define SMBIOS_END_OF_TABLE     127
 /** list of types which are known to have subtyes; expandable! */
 #define TYPES_WITH_SUBTYPES     185, 187, 208, 209, 210, 211, 212, 254
-/** maximum block size for proc read function */
-#define PROC_BLOCK_SIZE         (3*1024)
+/** number of types in TYPES_WITH_SUBTYPES */
+#define NO_OF_TYPES_WITH_SUBTYPES   8
+/** number of instance counters needed to name the files */
+#define SMBIOS_INSTANCE_COUNTERS    (256 * (NO_OF_TYPES_WITH_SUBTYPES + 1))
+/** marks an unused slot in the handle lookup table */
+#define SMBIOS_HANDLE_EMPTY     0xFFFFFFFF
+/** magic 4 bytes at the start of the map file */
+#define SMBIOS_MAP_MAGIC        0x50414D53 /* "SMAP" */
+/** strings recorded per structure, string numbers are one byte */
+#define SMBIOS_MAX_STRINGS      255
+/** longest structure including the strings, the index records the length in 16 bit */
+#define SMBIOS_MAX_STRUCT_LENGTH 0xFFFF
 
 
-/** mode raw/cooked */
+/** word with every byte set to 0x01 */
+#define ONES_WORD           (~0UL / 0xFF)
+/** non zero if one of the bytes of the word x is 0 */
+#define HAS_ZERO(x)         (((x) - ONES_WORD) & ~(x) & (ONES_WORD << 7))
+/** non zero if one of the bytes of the word x equals b */
+#define HAS_BYTE(x, b)      HAS_ZERO ((x) ^ (ONES_WORD * (b)))
+
+/** mode raw/cooked/key=value/binary */
 #define FILE_MODE_RAW       0
 #define FILE_MODE_COOKED    1
+#define FILE_MODE_KEYVALUE  2
+#define FILE_MODE_BINARY    3
+
+/** proc directory entry of an inode of the proc file system */
+#define SMBIOS_PDE(inode)   ((struct proc_dir_entry *) (inode)->u.generic_ip)
+
+/** number of cooked files per structure (/proc/smbios/cooked and /proc/smbios) */
+#define COOKED_FILES_PER_STRUCT     2
 
 
 
@@ -149,6 +185,33 @@ typedef struct smbios_entry_point_struct
   __u8  bcd_revision                   __attribute__ ((packed));
 } smbios_entry_point_struct;
 
+/** SM-BIOS 3.0 entry point structure
+ * the 64 bit entry point is found like the 32 bit one, by searching for the
+ * anchor string on paragraph boundaries within 000F0000h to 000FFFFFh. It
+ * has no structure count. The structure table is walked until the
+ * end-of-table structure (type 127), within the maximum table size.
+ */
+typedef struct smbios3_entry_point_struct
+{
+	/** "_SM3_", specified as five ASCII characters (5F 53 4D 33 5F) */
+  __u8  anchor_string[5]               __attribute__ ((packed));
+	/** checksum of the Entry Point Structure (EPS). This value, when added to
+	 * all other bytes in the EPS, will result in the value 00h. */
+  __u8  entry_point_checksum           __attribute__ ((packed));
+	/** Length of the Entry Point Structure, in bytes, currently 18h. */
+  __u8  entry_point_length             __attribute__ ((packed));
+  __u8  major_version                  __attribute__ ((packed));
+  __u8  minor_version                  __attribute__ ((packed));
+  __u8  docrev                         __attribute__ ((packed));
+	/** 01h for the entry point defined by SMBIOS 3.0 */
+  __u8  revision                       __attribute__ ((packed));
+  __u8  reserved                       __attribute__ ((packed));
+	/** maximum size of the structure table, the actual table may be shorter */
+  __u32 max_struct_table_size          __attribute__ ((packed));
+	/** the 64 bit physical starting address of the structure table */
+  __u64 struct_table_address           __attribute__ ((packed));
+} smbios3_entry_point_struct;
+
 /** SM-BIOS and DMI-BIOS structure header */
 typedef struct smbios_struct
 {
@@ -175,6 +238,104 @@ typedef struct dmibios_entry_point_struct
   dmibios_table_entry_struct entry[1]  __attribute__ ((packed));
 } dmibios_entry_point_struct;
 
+/** entry points found in the F-segment, see smbios_scan_anchors() */
+typedef struct smbios_anchors
+{
+  smbios_entry_point_struct *sm;
+  smbios3_entry_point_struct *sm3;
+  dmibios_entry_point_struct *dmi;
+} smbios_anchors;
+
+/** load-time index record, one per SM-BIOS, resp. DMI-BIOS structure.
+ * The index is built once while the structure table is walked, so the
+ * read functions never have to scan a structure again to find its end
+ * or to find one of its strings.
+ * The record is 16 bytes, i.e. four records share one cache line. The
+ * strings follow the formatted area, DMI-BIOS structures are converted
+ * to SM-BIOS format before they are recorded.
+ */
+typedef struct smbios_index_entry
+{
+	/** offset of the structure from smbios_index_base */
+  __u32 offset                         __attribute__ ((packed));
+	/** length of the structure in SM-BIOS format including the strings and
+	 * the terminating 0x0000 */
+  __u16 length                         __attribute__ ((packed));
+	/** position of the first string of the structure in smbios_string_refs */
+  __u32 strings                        __attribute__ ((packed));
+  __u16 handle                         __attribute__ ((packed));
+  __u8  type                           __attribute__ ((packed));
+  __u8  subtype                        __attribute__ ((packed));
+	/** length of the formatted area, i.e. the length field of the header */
+  __u8  formatted_length               __attribute__ ((packed));
+	/** number of strings of the structure recorded in smbios_string_refs */
+  __u8  string_count                   __attribute__ ((packed));
+} smbios_index_entry;
+
+/** load-time record of one string of a structure, see smbios_index_entry */
+typedef struct smbios_string_ref
+{
+	/** offset of the string from smbios_index_base */
+  __u32 offset                         __attribute__ ((packed));
+	/** length of the string without the terminating 0x00 */
+  __u32 length                         __attribute__ ((packed));
+} smbios_string_ref;
+
+/** header of the map file. The map is a read-only copy of the structure
+ * index, the string records and the structure table that applications
+ * can mmap(). All offsets are relative to the start of the map, the
+ * offset of an index record, resp. a string record, is relative to the
+ * table.
+ */
+typedef struct smbios_map_header
+{
+	/** SMBIOS_MAP_MAGIC */
+  __u32 magic                          __attribute__ ((packed));
+	/** length of this header */
+  __u16 header_length                  __attribute__ ((packed));
+	/** length of one smbios_index_entry */
+  __u16 index_entry_length             __attribute__ ((packed));
+  __u32 index_offset                   __attribute__ ((packed));
+  __u32 index_count                    __attribute__ ((packed));
+  __u32 strings_offset                 __attribute__ ((packed));
+  __u32 strings_count                  __attribute__ ((packed));
+  __u32 table_offset                   __attribute__ ((packed));
+  __u32 table_length                   __attribute__ ((packed));
+} smbios_map_header;
+
+/** cooked text of a structure. The structure is decoded when one of its
+ * files is read the first time, every output is rendered from the decoded
+ * structure when its file is read the first time. Both are kept until the
+ * module is unloaded.
+ */
+typedef struct smbios_cooked_entry
+{
+	/** output of bios_decode(), NULL as long as the structure was not read */
+  struct smbios_decoded *decoded;
+	/** output of bios_cook(), NULL as long as the cooked files were not read */
+  unsigned char *text;
+  unsigned int length;
+	/** the cooked files of the structure, their size is set once the text is known */
+  struct proc_dir_entry *file[COOKED_FILES_PER_STRUCT];
+  unsigned int no_of_files;
+	/** output of bios_cook_keyvalue(), NULL as long as the key=value file was not read */
+  unsigned char *keyvalue;
+  unsigned int keyvalue_length;
+  struct proc_dir_entry *keyvalue_file;
+	/** output of bios_cook_binary(), NULL as long as the binary file was not read */
+  unsigned char *binary;
+  unsigned int binary_length;
+  struct proc_dir_entry *binary_file;
+} smbios_cooked_entry;
+
+
+/** content of an open proc file */
+typedef struct smbios_file_buffer
+{
+  unsigned char *data;
+  unsigned int length;
+} smbios_file_buffer;
+
 
 /*
  *   Variables
@@ -182,41 +343,106 @@ typedef struct dmibios_entry_point_struct
 extern struct proc_dir_entry * smbios_proc_dir;             /* /proc/smbios */
 extern struct proc_dir_entry * smbios_raw_proc_dir;         /* /proc/smbios/raw */
 extern struct proc_dir_entry * smbios_cooked_proc_dir;      /* /proc/smbios/cooked */
+extern struct proc_dir_entry * smbios_keyvalue_proc_dir;    /* /proc/smbios/keyvalue */
+extern struct proc_dir_entry * smbios_binary_proc_dir;      /* /proc/smbios/binary */
 extern void * smbios_base;                                  /* F-Segment */
 extern smbios_entry_point_struct * smbios_entry_point;      /* start of SMBIOS within the F-Segment */
+extern smbios3_entry_point_struct * smbios3_entry_point;    /* start of SMBIOS 3.0 within the F-Segment */
 extern dmibios_entry_point_struct * dmibios_entry_point;    /* start of DMIBIOS within the F-Segment */
 extern void * smbios_structures_base;                       /* base of SMBIOS raw structures */
-extern unsigned char smbios_types_with_subtypes[];
+extern __u64 smbios_table_address;                          /* physical address of the SMBIOS structure table */
+extern __u32 smbios_table_length;                           /* length of the SMBIOS structure table */
+extern unsigned char smbios_types_with_subtypes[NO_OF_TYPES_WITH_SUBTYPES];
 extern char smbios_version_string[32];                      /* e.g. V2.31 */
+extern int smbios_snapshot_taken;                           /* 1 if the tables are copied to kernel memory */
+extern smbios_index_entry * smbios_index;                   /* one record per structure */
+extern unsigned int smbios_index_count;                     /* number of records in smbios_index */
+extern void * smbios_index_base;                            /* the index offsets are relative to this */
+extern smbios_string_ref * smbios_string_refs;              /* strings of all structures, see smbios_index_entry */
+extern smbios_cooked_entry * smbios_cooked_cache;           /* one record per structure, parallel to smbios_index */
 
 /*
  *   Functions
  */
 
+struct seq_file;
+
 /* for the description see the implementation file */
-smbios_entry_point_struct * smbios_find_entry_point(void * base);
-dmibios_entry_point_struct * dmibios_find_entry_point(void * base);
+void smbios_scan_anchors(void * base, unsigned int length, smbios_anchors * anchors);
+void smbios_set_version_string(void);
+unsigned long smbios_firmware_entry_point(void);
 unsigned char smbios_check_entry_point(void * addr);
+unsigned char smbios_check_intermediate_entry_point(void * addr);
+unsigned char smbios3_check_entry_point(void * addr);
+
+int smbios_snapshot(void);
+void smbios_release_structures(void);
+void smbios_release_base(void);
 
 int smbios_type_has_subtype(unsigned char type);
 
-int smbios_get_struct_length(smbios_struct * struct_ptr);
-int dmibios_get_struct_length(smbios_struct * struct_ptr);
+int smbios_get_struct_length(smbios_struct * struct_ptr, unsigned int limit);
+int dmibios_get_struct_length(smbios_struct * struct_ptr, unsigned int limit);
 
-int smbios_version_proc (char *page, char **start, off_t off, int count, int *eof, void *data);
-int bios_read_raw_proc(char * page, char ** start, off_t off, int count, int * eof, void * data);
-int bios_read_cooked_proc(char *page, char **start, off_t off, int count, int *eof, void *data);
-int dmibios_read_raw_proc(char * page, char ** start, off_t off, int count, int * eof, void * data);
-int dmibios_read_cooked_proc(char *page, char **start, off_t off, int count, int *eof, void *data);
+int bios_open_raw_proc(struct inode *inode, struct file *file);
+int bios_open_cooked_proc(struct inode *inode, struct file *file);
+int bios_open_keyvalue_proc(struct inode *inode, struct file *file);
+int bios_open_binary_proc(struct inode *inode, struct file *file);
+int smbios_open_binary_all_proc(struct inode *inode, struct file *file);
+int smbios_open_table_proc(struct inode *inode, struct file *file);
+int smbios_open_all_proc(struct inode *inode, struct file *file);
+int smbios_open_stats_proc(struct inode *inode, struct file *file);
+int smbios_stats_show(struct seq_file *m, void *v);
+void * smbios_all_start(struct seq_file *m, loff_t *pos);
+void * smbios_all_next(struct seq_file *m, void *v, loff_t *pos);
+void smbios_all_stop(struct seq_file *m, void *v);
+int smbios_all_show(struct seq_file *m, void *v);
+int smbios_mmap_map_proc(struct file *file, struct vm_area_struct *vma);
+int smbios_open_version_proc(struct inode *inode, struct file *file);
+ssize_t smbios_read_proc(struct file *file, char *buf, size_t count, loff_t *ppos);
+loff_t smbios_llseek_proc(struct file *file, loff_t offset, int origin);
+int smbios_release_proc(struct inode *inode, struct file *file);
 
-int smbios_make_dir_entries(struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir);
+int smbios_make_dir_entries(struct proc_dir_entry *smbiosdir, struct proc_dir_entry *rawdir, struct proc_dir_entry *cookeddir, struct proc_dir_entry *keyvaluedir, struct proc_dir_entry *binarydir);
 int smbios_make_version_entry(struct proc_dir_entry *smbiosdir);
-int dmibios_make_dir_entries(struct proc_dir_entry * smbiosdir, struct proc_dir_entry * rawdir, struct proc_dir_entry * cookeddir);
+int smbios_make_table_entries(struct proc_dir_entry *rawdir, unsigned int table_length);
+int smbios_make_all_entry(struct proc_dir_entry *smbiosdir, struct proc_dir_entry *binarydir);
+int smbios_make_stats_entry(struct proc_dir_entry *smbiosdir);
+int smbios_build_map(void);
+void smbios_free_map(void);
+int dmibios_make_dir_entries(struct proc_dir_entry * smbiosdir, struct proc_dir_entry * rawdir, struct proc_dir_entry * cookeddir, struct proc_dir_entry * keyvaluedir, struct proc_dir_entry * binarydir);
+int smbios_make_index_entries(struct proc_dir_entry * smbiosdir, struct proc_dir_entry * rawdir, struct proc_dir_entry * cookeddir, struct proc_dir_entry * keyvaluedir, struct proc_dir_entry * binarydir);
 
 void smbios_destroy_dir_entries(struct proc_dir_entry * dir);
 
+int smbios_alloc_index(unsigned int count);
+void smbios_free_index(void);
+smbios_index_entry * smbios_index_add(smbios_struct * struct_ptr, unsigned int length);
+smbios_struct * smbios_index_struct(smbios_index_entry * entry);
+smbios_index_entry * smbios_find_struct(smbios_struct * struct_ptr);
+
+int smbios_build_handle_table(void);
+smbios_index_entry * smbios_find_handle(__u16 handle);
+
+int smbios_create_caches(void);
+void smbios_destroy_caches(void);
+
+int smbios_alloc_cooked_cache(void);
+void smbios_free_cooked_cache(void);
+int smbios_get_cooked(smbios_index_entry * entry, unsigned char ** ptext, unsigned int * plength);
+int smbios_get_keyvalue(smbios_index_entry * entry, unsigned char ** ptext, unsigned int * plength);
+int smbios_get_binary(smbios_index_entry * entry, unsigned char ** pdata, unsigned int * plength);
+
 unsigned int smbios_get_readable_name_ext(char *readable_name, smbios_struct *struct_ptr);
 unsigned int smbios_get_readable_name(char *readable_name, smbios_struct *struct_ptr);
-int make_file_entries (char *filename, struct proc_dir_entry *dir, smbios_struct *struct_ptr, int mode);
+unsigned int smbios_instance_counter(smbios_index_entry *entry);
+#ifdef _DEBUG_
+/* benchmarks, see bench.c */
+void smbios_bench_reads(void * mapped, void * snapshot, unsigned int length);
+void smbios_bench_scan(void);
+void smbios_bench_struct_length(void);
+#endif
+
+int make_file_entries (char *filename, struct proc_dir_entry *dir, smbios_index_entry *entry, unsigned int instance, int mode);
 
 #endif /* __BIOS_H__ */
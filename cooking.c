@@ -57,7 +57,10 @@
 #include <linux/errno.h>	/* ... error codes */
 #include <linux/types.h>	/* ... fixed size types definitions, '__u8'... */
 #include <linux/proc_fs.h>  /* ... /proc file system ... */
-#include <linux/string.h>	/* ... for 'memcpy()', 'strncmp()' */
+#include <linux/string.h>	/* ... for 'memcpy()', 'strncmp()', 'strcmp()' */
+#include <linux/stddef.h>	/* ... for 'offsetof()' */
+#include <asm/bitops.h>		/* ... for 'ffs()' */
+#include <stdarg.h>		    /* ... for 'va_list' */
 
 
 #include "strgdef.h"        /* human readable output string definitions for directories,
@@ -65,3905 +68,2302 @@
                              */
 #include "bios.h"		    /* ... local declarations for DMI-, SM-BIOS */
 #include "cooking.h"	    /* ... local declarations for interpreting DMI- and SM-BIOS types */
+#include "strpool.h"        /* ... the strings of the decoding tables, generated by make */
 
 EXPORT_NO_SYMBOLS;
 
 
 
+/*
+ * descriptors of the structure types. Every type the module interprets
+ * has an array of field descriptors that tell where a field is, how wide
+ * it is and how it is shown. bios_decode() decodes a structure by them,
+ * the renderers bios_cook(), bios_cook_keyvalue() and bios_cook_binary()
+ * walk the decoded values. A new type needs its descriptors and an entry
+ * in smbios_layouts[] only.
+ */
 
-/** \fn unsigned char * bios_cook (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief huge switch that calls the cooking functions for every SMBIOS structure
-  * \param smbiosstruct pointer to SMBIOS raw structure
-  * \param plength amount of memory allocated by functions called from this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS structure. it calls the appropriate cooking function
-  * whitch interpretes the raw data and builds a string with the interpreted data.
-  * the caller is responsible to free the memory allocated by the "sub"-functions.
+/** the string at offset o of smbios_strings[], the names in the tables are such offsets */
+#define SMBIOS_STRING(o)            (smbios_strings + (o))
+
+/** offset and width of a member of a structure */
+#define FIELD_AT(t, m)              offset: offsetof (t, m), width: sizeof (((t *) 0)->m)
+/** names of the values, resp. of the bits of a field, offsets of strings of the pool */
+#define FIELD_NAMES(n)              names: n, no_of_names: sizeof (n) / sizeof (n[0])
+
+/** string */
+#define FIELD_STR(t, m, l)          FIELD_AT (t, m), kind: SMBIOS_FIELD_STRING, show: SMBIOS_SHOW_STRING, label: l
+/** number, shown by the format f */
+#define FIELD_NUM(t, m, l, f)       FIELD_AT (t, m), kind: SMBIOS_FIELD_INT, show: SMBIOS_SHOW_NUMBER, label: l, format: f
+/** enumeration, the values are shown by the names n, a table indexed by the value */
+#define FIELD_ENUM(t, m, l, n)      FIELD_AT (t, m), kind: SMBIOS_FIELD_INT, show: SMBIOS_SHOW_ENUM, label: l, FIELD_NAMES (n)
+/** bit field, the bits are named by n */
+#define FIELD_BITS(t, m, l, n)      FIELD_AT (t, m), kind: SMBIOS_FIELD_INT, show: SMBIOS_SHOW_BITS, label: l, FIELD_NAMES (n)
+/** bytes, shown in hex */
+#define FIELD_HEX(t, m, l)          FIELD_AT (t, m), kind: SMBIOS_FIELD_BYTES, show: SMBIOS_SHOW_HEX, label: l
+/** handle of another structure */
+#define FIELD_HANDLE(t, m, l)       FIELD_AT (t, m), kind: SMBIOS_FIELD_INT, show: SMBIOS_SHOW_HANDLE, label: l
+/** number, shown by the function c */
+#define FIELD_COOK(t, m, l, c)      FIELD_AT (t, m), kind: SMBIOS_FIELD_INT, show: SMBIOS_SHOW_COOK, label: l, cook: c
+/** the strings of the structure, as many as the byte at the member m says */
+#define FIELD_STRINGS(t, m, l)      kind: SMBIOS_FIELD_STRINGS, show: SMBIOS_SHOW_STRINGS, count: offsetof (t, m), label: l
+/** the following fields are shown only if the structure is longer than n */
+#define FIELD_ABOVE(n)              offset: n, show: SMBIOS_SHOW_ABOVE
+
+
+/*
+ * names shared by several types
+ */
+
+static const __u16 smbios_booleans[] = {
+    [0] = STR_SMB_FALSE,
+    [1] = STR_SMB_TRUE,
+};
+
+/** a field that is not shown if it is 0 */
+static const smbios_name smbios_hide_0[] = {
+    { 0, 0 },
+};
+
+/** a handle that is not shown if it is 0xFFFF */
+static const smbios_name smbios_hide_ffff[] = {
+    { 0xFFFF, 0 },
+};
+
+
+/** \fn static const smbios_name * bios_find_name (const smbios_field *field, unsigned int value)
+  * \brief looks up the name of a value of a field
+  * \param field the field
+  * \param value the value
+  * \return the name of the value, NULL if it has none
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the names of a number or handle are a few special values, e.g. a
+  * handle that is not shown. enumerations use bios_enum_name().
   */
 
-unsigned char *
-bios_cook (smbios_struct *smbiosstruct, unsigned int * plength)
+static const smbios_name *
+bios_find_name (const smbios_field *field, unsigned int value)
 {
-	unsigned char *scratch = NULL;      /* pointer that holds the interpreded data */
+    const smbios_name *names = (const smbios_name *) field->names;
+    unsigned int i;
 
 
-	/* do we have a valid SMBIOS? */
-	if ( !smbiosstruct )
-	   return NULL;
+    for (i = 0; i < field->no_of_names; i++)
+        if (names[i].value == value)
+            return &names[i];
 
-	/* switch between the different smbios types to interpret and call the appropriate
-	 * cook function.
-	 */
-	switch (smbiosstruct->type)
-	{
-        case 0:
-	        scratch = bios_cook_type_0 (smbiosstruct, plength);
-	        break;
-	    case 1:
-	        scratch = bios_cook_type_1 (smbiosstruct, plength);
-	        break;
-	    case 2:
-	        scratch = bios_cook_type_2 (smbiosstruct, plength);
-	        break;
-	    case 3:
-	        scratch = bios_cook_type_3 (smbiosstruct, plength);
-	        break;
-	    case 4:
-	        scratch = bios_cook_type_4 (smbiosstruct, plength);
-	        break;
-	    case 5:
-	        scratch = bios_cook_type_5 (smbiosstruct, plength);
-	        break;
-	    case 6:
-	        scratch = bios_cook_type_6 (smbiosstruct, plength);
-	        break;
-	    case 7:
-	        scratch = bios_cook_type_7 (smbiosstruct, plength);
-	        break;
-	    case 8:	
-	        scratch = bios_cook_type_8 (smbiosstruct, plength);	
-	        break;	
-	    case 9:	
-	        scratch = bios_cook_type_9 (smbiosstruct, plength);	
-	        break;
-	    case 10:	
-	        scratch = bios_cook_type_10 (smbiosstruct, plength);	
-	        break;	
-	    case 11:	
-	        scratch = bios_cook_type_11 (smbiosstruct, plength);	
-	        break;
-	    case 12:	
-	        scratch = bios_cook_type_12 (smbiosstruct, plength);	
-	        break;    	
-	    case 13:	
-	        scratch = bios_cook_type_13 (smbiosstruct, plength);	
-	        break;
-	    case 16:	
-	        scratch = bios_cook_type_16 (smbiosstruct, plength);	
-	        break;
-	    case 17:	
-	        scratch = bios_cook_type_17 (smbiosstruct, plength);	
-	        break;
-	    case 19:	
-	        scratch = bios_cook_type_19 (smbiosstruct, plength);	
-	        break;
-	    case 20:	
-	        scratch = bios_cook_type_20 (smbiosstruct, plength);	
-	        break;
-	    case 32:	
-	        scratch = bios_cook_type_32 (smbiosstruct, plength);	
-	        break;
-	    case 127:	
-	        scratch = bios_cook_type_127 (smbiosstruct, plength);	
-	        break;        	
-	
-
-		/* if it's none of the supported types, just display the standard
-		 * DMI header */
-	    default:
-	        {
-                unsigned char line[512];
-                unsigned char line_type[128];     /* type */
-                unsigned char line_length[128];   /* length */
-                unsigned char line_handle[128];   /* handle */
-                unsigned char line_text[128];     /* not supported message */
-
-                /* prepare type, length, handle and not supported message */
-                sprintf (line_type, "%20s : %d\n", TYPE, smbiosstruct->type);
-                sprintf (line_length, "%20s : %d %s\n", LENGTH, smbiosstruct->length, BYTES);
-                sprintf (line_handle, "%20s : %d\n", HANDLE, smbiosstruct->handle);
-	            sprintf (line_text, "\n%s\n\n", NOT_SUPPORTED);
-
-                sprintf (line, "%s%s%s%s", line_type, line_length, line_handle, line_text);
-                *plength = strlen (line);
-
-                /* allocate memory ... */
-                scratch = kmalloc (*plength+1, GFP_KERNEL);
-                if (scratch == NULL)
-                {
-                    *plength = 0;
-                    return NULL;
-                }
-	
-                /* ... and copy the string */
-                memcpy (scratch, line, *plength);
-            }
-	} /* end switch */
-	
-	/* return a string with all the interpreted data for the given raw structure */
-	/* the caller is responsible to free the memory. */
-	return scratch;
+    return NULL;
 }
 
 
-/** \fn unsigned char * bios_cook_type_0 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 0 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 0 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 0 (Bios) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+/** \fn static const char * bios_enum_name (const smbios_field *field, __u64 value)
+  * \brief looks up the name of a value of an enumeration
+  * \param field the enumeration
+  * \param value the value
+  * \return the name of the value, NULL if it has none
   */
 
-unsigned char *
-bios_cook_type_0 (smbios_struct * smbiosstruct, unsigned int * plength)
+static const char *
+bios_enum_name (const smbios_field *field, __u64 value)
 {
-	smbios_type_0 *type0;
-    unsigned char * scratch;
-
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
-
-	/* contains one line of the above file */
-    unsigned char line[128];
-
-
-    /* cast raw data to type 0 structure */
-    type0 = (smbios_type_0 *)smbiosstruct;
-
-    /* prepare header string */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE0_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-	/* prepare strings with type 0 information */
-	sprintf (line, "%-35s%s %s\n", TYPE0_VENDOR, SEP1, GetString(smbiosstruct, (unsigned int)(type0->vendor)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE0_VERSION, SEP1, GetString(smbiosstruct, (unsigned int)(type0->version)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %X\n", TYPE0_ADR_SEG, SEP1, type0->startaddr);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE0_REL_DATE, SEP1, GetString(smbiosstruct, (unsigned int)(type0->reldate)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d kB\n", TYPE0_ROM_SIZE, SEP1, ((type0->romsize)+1) * 64);
-	strcat(file, line);
-	
-
-    /* bios characteristics interpretation */
-    sprintf(line, "%-35s%s\n", TYPE0_CHAR, SEP1);
-    strcat(file, line);
-    if( (type0->characteristics) & 0x0000000000000001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_RES);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_RES);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_NOTSUP);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_ISA);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_MCA);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_EISA);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000080 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PCI);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000100 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PCMCIA);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000200 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PNP);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000400 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_APM);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000000800 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_FLASH);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000001000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_SHADOWING);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000002000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_VL);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000004000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_ESCD);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000008000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_BOOTCD);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000010000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_SELBOOT);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000020000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_BIOS_IS_SOCKETED);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000040000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PCMCIA_BOOT);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000080000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_ENH_DISK_DRIVE);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000100000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_FD_NEC);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000200000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_FD_TOSHIBA);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000400000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_360);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000000800000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_1200);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000001000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_720);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000002000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_2880);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000004000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PRINT_SCREEN);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000008000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_KEYBOARD);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000010000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_SER_SERVICES);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000020000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PRINT_SERVICES);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000040000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_VIDEO_SERVICES);
-        strcat(file, line);
-    }
-    if( (type0->characteristics) & 0x0000000080000000 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_CHAR_PC98);
-        strcat(file, line);
-    }
+    const __u16 *names = (const __u16 *) field->names;
 
-    if(smbiosstruct->length > 0x12)
-    {
-        /* interpretation of extension byte 1 */
-        if( (type0->ext1) & 0x01 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_ACPI);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x02 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_USB);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x04 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_AGP);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x08 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_I2O_BOOT);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x10 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_LS120);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x20 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_ATAPI_ZIP_BOOT);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x40 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_1394_BOOT);
-            strcat(file, line);
-        }
-        if( (type0->ext1) & 0x80 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT1_SMART_BATTERY);
-            strcat(file, line);
-        }
-    }
 
-    if(smbiosstruct->length > 0x13)
+    return value < field->no_of_names && names[value] ? SMBIOS_STRING (names[value]) : NULL;
+}
+
+
+/** \fn static __u64 bios_field_value (smbios_struct *smbiosstruct, const smbios_field *field, unsigned int offset)
+  * \brief reads an integer field
+  * \param smbiosstruct pointer to SMBIOS raw structure
+  * \param field the field
+  * \param offset offset of the field in the structure
+  * \return the bits of the value the field shows
+  */
+
+static __u64
+bios_field_value (smbios_struct *smbiosstruct, const smbios_field *field, unsigned int offset)
+{
+    unsigned char *ptr = (unsigned char *) smbiosstruct + offset;
+    __u64 value;
+
+
+    switch (field->width)
     {
-        /* interpretation of extension byte 2 */
-        if( (type0->ext2) & 0x01 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT2_BBS);
-            strcat(file, line);
-        }
-        if( (type0->ext2) & 0x02 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE0_EXT2_NETWORK_BOOT);
-            strcat(file, line);
-        }
+        case 1:     value = *ptr;
+                    break;
+        case 2:     value = *(__u16 *) ptr;
+                    break;
+        case 4:     value = *(__u32 *) ptr;
+                    break;
+        default:    value = *(__u64 *) ptr;
     }
 
-	
-    /* now line contains a string with fully interpreted type 0 data */
-	*plength = strlen(file);
+    if (field->mask)
+        value = (value & field->mask) >> field->shift;
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+    return value;
+}
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
 
-	/* return a string with all the interpreted data for the given raw structure. */	
-	/* the caller is responsible to free the memory. */	
-	return scratch;
-	
+/** \fn static __u64 bios_field_bits (const smbios_field *field, __u64 value)
+  * \brief returns the bits of a value that have a name
+  * \param field the bit field
+  * \param value the value
+  * \return the bits of the value below field->no_of_names
+  */
+
+static __u64
+bios_field_bits (const smbios_field *field, __u64 value)
+{
+    if (field->no_of_names >= 64)
+        return value;
+
+    return value & (((__u64) 1 << field->no_of_names) - 1);
 }
 
 
-/** \fn unsigned char * bios_cook_type_1 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 1 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 1 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static int bios_next_bit (__u64 *mask)
+  * \brief takes the lowest bit that is set out of a mask
+  * \param mask [IN/OUT]-Param. the bits, the bit is cleared
+  * \return number of the bit, -1 if no bit is set
   *
-  * this function gets a raw SMBIOS Type 1 (System) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the bit is found by ffs(), so walking a bit field takes one step per
+  * bit that is set, no matter how many bits the field has.
   */
 
-unsigned char *
-bios_cook_type_1 (smbios_struct * smbiosstruct, unsigned int *plength)
+static int
+bios_next_bit (__u64 *mask)
 {
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
+    __u32 low = *mask;
+    __u32 high = *mask >> 32;
+    int bit;
 
-	smbios_type_1 *type1;
-    unsigned char * scratch;
 
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
+    if (low)
+        bit = ffs (low) - 1;
+    else if (high)
+        bit = ffs (high) + 31;
+    else
+        return -1;
 
-	/* contains one line of the above file */
-    unsigned char line[128];
+    /* clear the lowest bit that is set */
+    *mask &= *mask - 1;
 
-    unsigned char help[8];                  /* helper string */
-    int i;
+    return bit;
+}
 
 
-    /* cast our data ptr to a structure ptr of SMBIOS type 1 */
-    type1 = (smbios_type_1 *)smbiosstruct;
+/** \fn static const smbios_value * bios_find_value (const smbios_decoded *decoded, unsigned int offset)
+  * \brief looks up the decoded value of the field at an offset
+  * \param decoded the decoded structure
+  * \param offset offset of the field in the structure
+  * \return the first value of the field, NULL if it was not decoded
+  */
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE1_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-	
-	/* prepare interpreted type 1 string */
-	sprintf (line, "%-35s%s %s\n", TYPE1_MANUFACTURER, SEP1, GetString(smbiosstruct, (unsigned int)(type1->manufacturer)));
-    strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE1_PRODUCT_NAME, SEP1, GetString(smbiosstruct, (unsigned int)(type1->productname)));
-	strcat(file, line);	
-	sprintf (line, "%-35s%s %s\n", TYPE1_VERSION, SEP1, GetString(smbiosstruct, (unsigned int)(type1->version)));
-	strcat(file, line);	
-	sprintf (line, "%-35s%s %s\n", TYPE1_SERIAL_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type1->serialnumber)));
-	strcat(file, line);
-
-	
-    /* if smbios 2.1 or higher */
-    if(smbiosstruct->length > 0x08)		
-	{
-  	    sprintf(line, "%-35s%s ", TYPE1_UUID, SEP1);
-  	    strcat(file, line);
-  	    for (i=0; i<16; i++)
- 		{
-			sprintf(help, "%.2X ", type1->uuid[i]);
-  	        strcat(file, help);
-		}
-		strcat(file, "\n");
-
-		switch(type1->wakeuptype)
-		{
-			case 0:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_RESERVED);
-						break;
-			case 1:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_OTHER);
-						break;
-			case 2:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_UNKNOWN);
-						break;
-			case 3:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_APM);
-						break;
-			case 4:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_MODEM);
-						break;
-			case 5:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_LAN);
-						break;
-			case 6:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_POWER_SWITCH);
-						break;
-			case 7:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_PCI_PME);
-						break;
-			case 8:		sprintf (line, "%-35s%s %s\n", TYPE1_WAKEUP, SEP1, TYPE1_WT_AC_PWR_RESTORE);
-						break;
-			default:    sprintf (line, "%-35s%s %d\n", TYPE1_WAKEUP, SEP1, type1->wakeuptype);
-		}
-  	    strcat(file, line);
-	} /* end - if smbios 2.1 or higher */
-
-	/* now line contains a string with fully interpreted type 1 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+static const smbios_value *
+bios_find_value (const smbios_decoded *decoded, unsigned int offset)
+{
+    unsigned int i;
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
 
-	/* return a string with all the interpreted data for the given raw structure. */	
-    /* the caller is responsible to free the memory. */	
-    return scratch;
+    for (i = 0; i < decoded->no_of_values; i++)
+        if (decoded->values[i].offset == offset && decoded->values[i].field->kind)
+            return &decoded->values[i];
 
+    return NULL;
 }
 
 
-/** \fn unsigned char * bios_cook_type_2 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 2 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 2 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static void bios_append (smbios_render *render, const char *text, unsigned int length)
+  * \brief appends text to the output of a renderer
+  * \param render the output
+  * \param text the text
+  * \param length bytes of the text
   *
-  * this function gets a raw SMBIOS Type 2 (BaseBoard) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the text is copied behind the output so far, so appending never
+  * rescans the output. text that does not fit into the output is cut and
+  * the overflow is flagged. without output the text is only counted.
   */
 
-unsigned char *
-bios_cook_type_2 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_append (smbios_render *render, const char *text, unsigned int length)
 {
-	smbios_type_2 *type2;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
-
-	/* contains one line of the above file */
-    unsigned char line[128];
-
-
-    /* cast our data ptr to a structure ptr of SMBIOS type 2 */
-    type2 = (smbios_type_2 *)smbiosstruct;
-
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE2_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-	/* prepare interpreted type 2 strings */
-	sprintf (line, "%-35s%s %s\n", TYPE2_MANUFACTURER, SEP1, GetString(smbiosstruct, (unsigned int)(type2->manufacturer)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE2_PRODUCT, SEP1, GetString(smbiosstruct, (unsigned int)(type2->product)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE2_VERSION, SEP1, GetString(smbiosstruct, (unsigned int)(type2->version)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE2_SERIAL_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type2->serialnumber)));
-	strcat(file, line);
-
-
-    /* now line contains a string with fully interpreted type 2 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+    if (!render->out)
+    {
+        render->length += length;
+        return;
+    }
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+    if (length > render->size - render->length)
+    {
+        length = render->size - render->length;
+        render->overflow = 1;
+    }
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+    memcpy (render->out + render->length, text, length);
+    render->length += length;
 }
 
 
-/** \fn unsigned char * bios_cook_type_3 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 3 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 3 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static void bios_printf (smbios_render *render, const char *format, ...)
+  * \brief formats a piece of the interpreted data and appends it to the output
+  * \param render the output
+  * \param format format of the piece, as for printk()
   *
-  * this function gets a raw SMBIOS Type 3 (Enclosure, Chassis) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * a piece is formatted on the stack if it is shorter than
+  * SMBIOS_RENDER_PIECE characters, a longer one, e.g. with a long string,
+  * in memory of its own. if there is none, the piece is cut and the
+  * overflow is flagged.
   */
 
-unsigned char *
-bios_cook_type_3 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_printf (smbios_render *render, const char *format, ...)
 {
-	smbios_type_3 *type3;
-    unsigned char * scratch;
-	
-    /* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
+    char text[SMBIOS_RENDER_PIECE];
+    char *long_text;
+    va_list args;
+    int length;
 
-	/* contains one line of the above file */
-    unsigned char line[128];
 
+    va_start (args, format);
+    length = vsnprintf (text, sizeof (text), format, args);
+    va_end (args);
 
-    /* cast our data ptr to a structure ptr of SMBIOS type 3 */
-    type3 = (smbios_type_3 *)smbiosstruct;
-
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE3_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-	sprintf (line, "%-35s%s %s\n", TYPE3_MANUFACTURER, SEP1, GetString(smbiosstruct, (unsigned int)(type3->manufacturer)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE3_VERSION, SEP1, GetString(smbiosstruct, (unsigned int)(type3->version)));
-	strcat(file, line);
-	sprintf (line, "%-35s%s %s\n", TYPE3_SERIAL_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type3->serialnumber)));
-	strcat(file, line);
-    sprintf (line, "%-35s%s %s\n", TYPE3_ASSET_TAG, SEP1, GetString(smbiosstruct, (unsigned int)(type3->asset_tag)));
-    strcat(file, line);
-
- 	
-    if(type3->type &0x80)
-        sprintf (line, "%-35s%s %s\n", TYPE3_CHASSIS_LOCK, SEP1, TYPE3_CL_PRESENT);
-    else
-        sprintf (line, "%-35s%s %s\n", TYPE3_CHASSIS_LOCK, SEP1, TYPE3_CL_NOT_PRESENT);
- 	strcat(file, line);
-
-    switch(type3->type & 0x7F)
-	{
-		case 1:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_OTHER);
-					break;
-		case 2:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_UNKNOWN);
-					break;
-		case 3:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_DESKTOP);
-					break;
-		case 4:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_LOW_PROFILE);
-					break;
-		case 5:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_PIZZA_BOX);
-					break;
-		case 6:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_MINI_TOWER);
-					break;
-		case 7:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_TOWER);
-					break;
-		case 8:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_PORTABLE);
-					break;
-		case 9:		sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_LAPTOP);
-					break;
-		case 10:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_NOTEBOOK);
-					break;
-		case 11:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_HANDHELD);
-					break;
-		case 12:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_DOCKING_STATION);
-					break;
-        case 13:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_ALL_IN_ONE);
-					break;
-		case 14:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_SUB_NOTEBOOK);
-					break;
-		case 15:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_SPACE_SAVING);
-					break;
-		case 16:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_LUNCH_BOX);
-					break;
-		case 17:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_MAIN_SERVER_CHASSIS);
-					break;
-		case 18:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_EXPANSION_CHASSIS);
-					break;
-		case 19:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_SUB_CHASSIS);
-					break;
-		case 20:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_BUS_EXP_CHASSIS);
-					break;
-		case 21:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_PERIPHERAL_CHASSIS);
-					break;
-		case 22:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_RAID_CHASSIS);
-					break;
-		case 23:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_RACK_MOUNT_CHASSIS);
-					break;
-		case 24:	sprintf (line, "%-35s%s %s\n", TYPE3_TYPE, SEP1, TYPE3_TYPE_SEALED_CASE_PC);
-					break;
-		default:    sprintf (line, "%-35s%s %d\n", TYPE3_TYPE, SEP1, type3->type & 0x7F);
-	}
-    strcat(file, line);
+    if (length < 0)
+        return;
 
-    /* SMBIOS 2.1 and higher */
-    if(smbiosstruct->length > 0x09)
+    if (length >= (int) sizeof (text))
     {
- 		switch(type3->bootup_state)
-		{
-			case 1:		sprintf (line, "%-35s%s %s\n", TYPE3_BOOT_STATE, SEP1, TYPE3_STATE_OTHER);
-						break;
-			case 2:		sprintf (line, "%-35s%s %s\n", TYPE3_BOOT_STATE, SEP1, TYPE3_STATE_UNKNOWN);
-						break;
-			case 3:		sprintf (line, "%-35s%s %s\n", TYPE3_BOOT_STATE, SEP1, TYPE3_STATE_SAFE);
-						break;
-			case 4:		sprintf (line, "%-35s%s %s\n", TYPE3_BOOT_STATE, SEP1, TYPE3_STATE_WARNING);
-						break;
-			case 5:		sprintf (line, "%-35s%s %s\n", TYPE3_BOOT_STATE, SEP1, TYPE3_STATE_CRITICAL);
-						break;
-			case 6:		sprintf (line, "%-35s%s %s\n", TYPE3_BOOT_STATE, SEP1, TYPE3_STATE_NON_RECOVERABLE);
-						break;
-			default:    sprintf (line, "%-35s%s %d\n", TYPE3_BOOT_STATE, SEP1, type3->bootup_state);
-		}
-  	    strcat(file,line);
-
-        switch(type3->pwr_supply_state)
-		{
-			case 1:		sprintf (line, "%-35s%s %s\n", TYPE3_POWER_SUPPLY_STATE, SEP1, TYPE3_STATE_OTHER);
-						break;
-			case 2:		sprintf (line, "%-35s%s %s\n", TYPE3_POWER_SUPPLY_STATE, SEP1, TYPE3_STATE_UNKNOWN);
-						break;
-		    case 3:		sprintf (line, "%-35s%s %s\n", TYPE3_POWER_SUPPLY_STATE, SEP1, TYPE3_STATE_SAFE);
-						break;
-			case 4:		sprintf (line, "%-35s%s %s\n", TYPE3_POWER_SUPPLY_STATE, SEP1, TYPE3_STATE_WARNING);
-						break;
-			case 5:		sprintf (line, "%-35s%s %s\n", TYPE3_POWER_SUPPLY_STATE, SEP1, TYPE3_STATE_CRITICAL);
-						break;
-			case 6:		sprintf (line, "%-35s%s %s\n", TYPE3_POWER_SUPPLY_STATE, SEP1, TYPE3_STATE_NON_RECOVERABLE);
-						break;
-			default:    sprintf (line, "%-35s%s %d\n", TYPE3_POWER_SUPPLY_STATE, SEP1, type3->bootup_state);
-		}
-  	    strcat(file,line);
-
-        switch(type3->thermal_state)
-		{
-			case 1:		sprintf (line, "%-35s%s %s\n", TYPE3_THERMAL_STATE, SEP1, TYPE3_STATE_OTHER);
-						break;
-			case 2:		sprintf (line, "%-35s%s %s\n",  TYPE3_THERMAL_STATE, SEP1, TYPE3_STATE_UNKNOWN);
-						break;
-			case 3:		sprintf (line, "%-35s%s %s\n",  TYPE3_THERMAL_STATE, SEP1, TYPE3_STATE_SAFE);
-						break;
-			case 4:		sprintf (line, "%-35s%s %s\n",  TYPE3_THERMAL_STATE, SEP1, TYPE3_STATE_WARNING);
-						break;
-			case 5:		sprintf (line, "%-35s%s %s\n",  TYPE3_THERMAL_STATE, SEP1, TYPE3_STATE_CRITICAL);
-						break;
-			case 6:		sprintf (line, "%-35s%s %s\n",  TYPE3_THERMAL_STATE, SEP1, TYPE3_STATE_NON_RECOVERABLE);
-						break;
-			default:    sprintf (line, "%-35s%s %d\n",  TYPE3_THERMAL_STATE, SEP1, type3->thermal_state);
-		}
-  	    strcat(file,line);
-
-        switch(type3->security_state)
-		{
-			case 1:		sprintf (line, "%-35s%s %s\n", TYPE3_SECURITY_STATE, SEP1, TYPE3_SEC_OTHER);
-						break;
-			case 2:		sprintf (line, "%-35s%s %s\n", TYPE3_SECURITY_STATE, SEP1, TYPE3_SEC_UNKNOWN);
-						break;
-			case 3:		sprintf (line, "%-35s%s %s\n", TYPE3_SECURITY_STATE, SEP1, TYPE3_SEC_NONE);
-						break;
-			case 4:		sprintf (line, "%-35s%s %s\n", TYPE3_SECURITY_STATE, SEP1, TYPE3_SEC_EXT_LOCKED_OUT);
-						break;
-			case 5:		sprintf (line, "%-35s%s %s\n", TYPE3_SECURITY_STATE, SEP1, TYPE3_SEC_EXT_ENABLED);
-						break;
-			default:    sprintf (line, "%-35s%s %d\n", TYPE3_SECURITY_STATE, SEP1, type3->security_state);
-		}
-  	    strcat(file,line);
+        if ((long_text = kmalloc (length + 1, GFP_KERNEL)))
+        {
+            va_start (args, format);
+            vsnprintf (long_text, length + 1, format, args);
+            va_end (args);
 
+            bios_append (render, long_text, length);
+            kfree (long_text);
+            return;
+        }
+
+        length = sizeof (text) - 1;
+        render->overflow = 1;
     }
 
+    bios_append (render, text, length);
+}
+
+
+/*
+ * type 0 - bios information
+ */
+
+static const __u16 type0_characteristics[] = {
+    STR_TYPE0_CHAR_RES,
+    STR_TYPE0_CHAR_RES,
+    STR_TYPE0_CHAR_UNKNOWN,
+    STR_TYPE0_CHAR_NOTSUP,
+    STR_TYPE0_CHAR_ISA,
+    STR_TYPE0_CHAR_MCA,
+    STR_TYPE0_CHAR_EISA,
+    STR_TYPE0_CHAR_PCI,
+    STR_TYPE0_CHAR_PCMCIA,
+    STR_TYPE0_CHAR_PNP,
+    STR_TYPE0_CHAR_APM,
+    STR_TYPE0_CHAR_FLASH,
+    STR_TYPE0_CHAR_SHADOWING,
+    STR_TYPE0_CHAR_VL,
+    STR_TYPE0_CHAR_ESCD,
+    STR_TYPE0_CHAR_BOOTCD,
+    STR_TYPE0_CHAR_SELBOOT,
+    STR_TYPE0_CHAR_BIOS_IS_SOCKETED,
+    STR_TYPE0_CHAR_PCMCIA_BOOT,
+    STR_TYPE0_CHAR_ENH_DISK_DRIVE,
+    STR_TYPE0_CHAR_FD_NEC,
+    STR_TYPE0_CHAR_FD_TOSHIBA,
+    STR_TYPE0_CHAR_360,
+    STR_TYPE0_CHAR_1200,
+    STR_TYPE0_CHAR_720,
+    STR_TYPE0_CHAR_2880,
+    STR_TYPE0_CHAR_PRINT_SCREEN,
+    STR_TYPE0_CHAR_KEYBOARD,
+    STR_TYPE0_CHAR_SER_SERVICES,
+    STR_TYPE0_CHAR_PRINT_SERVICES,
+    STR_TYPE0_CHAR_VIDEO_SERVICES,
+    STR_TYPE0_CHAR_PC98,
+};
+static const __u16 type0_ext1[] = {
+    STR_TYPE0_EXT1_ACPI,
+    STR_TYPE0_EXT1_USB,
+    STR_TYPE0_EXT1_AGP,
+    STR_TYPE0_EXT1_I2O_BOOT,
+    STR_TYPE0_EXT1_LS120,
+    STR_TYPE0_EXT1_ATAPI_ZIP_BOOT,
+    STR_TYPE0_EXT1_1394_BOOT,
+    STR_TYPE0_EXT1_SMART_BATTERY,
+};
+static const __u16 type0_ext2[] = {
+    STR_TYPE0_EXT2_BBS,
+    STR_TYPE0_EXT2_NETWORK_BOOT,
+};
+static const smbios_field type_0_fields[] = {
+    { FIELD_STR (smbios_type_0, vendor, TYPE0_VENDOR) },
+    { FIELD_STR (smbios_type_0, version, TYPE0_VERSION) },
+    { FIELD_NUM (smbios_type_0, startaddr, TYPE0_ADR_SEG, "%-35s%s %X\n") },
+    { FIELD_STR (smbios_type_0, reldate, TYPE0_REL_DATE) },
+    { FIELD_NUM (smbios_type_0, romsize, TYPE0_ROM_SIZE, "%-35s%s %d kB\n"), calc: SMBIOS_CALC_64K },
+    { FIELD_BITS (smbios_type_0, characteristics, TYPE0_CHAR, type0_characteristics) },
+    /* SMBIOS 2.1 and higher */
+    { FIELD_ABOVE (0x12) },
+    { FIELD_BITS (smbios_type_0, ext1, NULL, type0_ext1) },
     /* SMBIOS 2.3 and higher */
-    if(smbiosstruct->length > 0x0D)
-    {
-        sprintf(line, "%-35s%s %.8X h\n", TYPE3_OEM_DEFINED, SEP1, type3->oem_defined);
-        strcat(file, line);
-    }
+    { FIELD_ABOVE (0x13) },
+    { FIELD_BITS (smbios_type_0, ext2, NULL, type0_ext2) },
+};
 
-    /* now line contains a string with fully interpreted type 3 data */
-	*plength = strlen(file);
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
+/*
+ * type 1 - system information
+ */
 
-		return NULL;
-	}
+static const __u16 type1_wakeup_types[] = {
+    [0] = STR_TYPE1_WT_RESERVED,
+    [1] = STR_TYPE1_WT_OTHER,
+    [2] = STR_TYPE1_WT_UNKNOWN,
+    [3] = STR_TYPE1_WT_APM,
+    [4] = STR_TYPE1_WT_MODEM,
+    [5] = STR_TYPE1_WT_LAN,
+    [6] = STR_TYPE1_WT_POWER_SWITCH,
+    [7] = STR_TYPE1_WT_PCI_PME,
+    [8] = STR_TYPE1_WT_AC_PWR_RESTORE,
+};
+static const smbios_field type_1_fields[] = {
+    { FIELD_STR (smbios_type_1, manufacturer, TYPE1_MANUFACTURER) },
+    { FIELD_STR (smbios_type_1, productname, TYPE1_PRODUCT_NAME) },
+    { FIELD_STR (smbios_type_1, version, TYPE1_VERSION) },
+    { FIELD_STR (smbios_type_1, serialnumber, TYPE1_SERIAL_NUMBER) },
+    /* SMBIOS 2.1 and higher */
+    { FIELD_ABOVE (0x08) },
+    { FIELD_HEX (smbios_type_1, uuid, TYPE1_UUID) },
+    { FIELD_ENUM (smbios_type_1, wakeuptype, TYPE1_WAKEUP, type1_wakeup_types) },
+};
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+/*
+ * type 2 - base board information
+ */
 
-}
+static const smbios_field type_2_fields[] = {
+    { FIELD_STR (smbios_type_2, manufacturer, TYPE2_MANUFACTURER) },
+    { FIELD_STR (smbios_type_2, product, TYPE2_PRODUCT) },
+    { FIELD_STR (smbios_type_2, version, TYPE2_VERSION) },
+    { FIELD_STR (smbios_type_2, serialnumber, TYPE2_SERIAL_NUMBER) },
+};
 
 
-/** \fn unsigned char * bios_cook_type_4 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 4 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 4 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 4 (Processor) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+/*
+ * type 3 - system enclosure information
+ */
+
+static const __u16 type3_chassis_locks[] = {
+    [0] = STR_TYPE3_CL_NOT_PRESENT,
+    [1] = STR_TYPE3_CL_PRESENT,
+};
+
+static const __u16 type3_types[] = {
+    [1] = STR_TYPE3_TYPE_OTHER,
+    [2] = STR_TYPE3_TYPE_UNKNOWN,
+    [3] = STR_TYPE3_TYPE_DESKTOP,
+    [4] = STR_TYPE3_TYPE_LOW_PROFILE,
+    [5] = STR_TYPE3_TYPE_PIZZA_BOX,
+    [6] = STR_TYPE3_TYPE_MINI_TOWER,
+    [7] = STR_TYPE3_TYPE_TOWER,
+    [8] = STR_TYPE3_TYPE_PORTABLE,
+    [9] = STR_TYPE3_TYPE_LAPTOP,
+    [10] = STR_TYPE3_TYPE_NOTEBOOK,
+    [11] = STR_TYPE3_TYPE_HANDHELD,
+    [12] = STR_TYPE3_TYPE_DOCKING_STATION,
+    [13] = STR_TYPE3_TYPE_ALL_IN_ONE,
+    [14] = STR_TYPE3_TYPE_SUB_NOTEBOOK,
+    [15] = STR_TYPE3_TYPE_SPACE_SAVING,
+    [16] = STR_TYPE3_TYPE_LUNCH_BOX,
+    [17] = STR_TYPE3_TYPE_MAIN_SERVER_CHASSIS,
+    [18] = STR_TYPE3_TYPE_EXPANSION_CHASSIS,
+    [19] = STR_TYPE3_TYPE_SUB_CHASSIS,
+    [20] = STR_TYPE3_TYPE_BUS_EXP_CHASSIS,
+    [21] = STR_TYPE3_TYPE_PERIPHERAL_CHASSIS,
+    [22] = STR_TYPE3_TYPE_RAID_CHASSIS,
+    [23] = STR_TYPE3_TYPE_RACK_MOUNT_CHASSIS,
+    [24] = STR_TYPE3_TYPE_SEALED_CASE_PC,
+};
+static const __u16 type3_states[] = {
+    [1] = STR_TYPE3_STATE_OTHER,
+    [2] = STR_TYPE3_STATE_UNKNOWN,
+    [3] = STR_TYPE3_STATE_SAFE,
+    [4] = STR_TYPE3_STATE_WARNING,
+    [5] = STR_TYPE3_STATE_CRITICAL,
+    [6] = STR_TYPE3_STATE_NON_RECOVERABLE,
+};
+static const __u16 type3_security_states[] = {
+    [1] = STR_TYPE3_SEC_OTHER,
+    [2] = STR_TYPE3_SEC_UNKNOWN,
+    [3] = STR_TYPE3_SEC_NONE,
+    [4] = STR_TYPE3_SEC_EXT_LOCKED_OUT,
+    [5] = STR_TYPE3_SEC_EXT_ENABLED,
+};
+static const smbios_field type_3_fields[] = {
+    { FIELD_STR (smbios_type_3, manufacturer, TYPE3_MANUFACTURER) },
+    { FIELD_STR (smbios_type_3, version, TYPE3_VERSION) },
+    { FIELD_STR (smbios_type_3, serialnumber, TYPE3_SERIAL_NUMBER) },
+    { FIELD_STR (smbios_type_3, asset_tag, TYPE3_ASSET_TAG) },
+    { FIELD_ENUM (smbios_type_3, type, TYPE3_CHASSIS_LOCK, type3_chassis_locks), mask: 0x80, shift: 7 },
+    { FIELD_ENUM (smbios_type_3, type, TYPE3_TYPE, type3_types), mask: 0x7F, flags: SMBIOS_FLAG_SAME },
+    /* SMBIOS 2.1 and higher */
+    { FIELD_ABOVE (0x09) },
+    { FIELD_ENUM (smbios_type_3, bootup_state, TYPE3_BOOT_STATE, type3_states) },
+    { FIELD_ENUM (smbios_type_3, pwr_supply_state, TYPE3_POWER_SUPPLY_STATE, type3_states) },
+    { FIELD_ENUM (smbios_type_3, thermal_state, TYPE3_THERMAL_STATE, type3_states) },
+    { FIELD_ENUM (smbios_type_3, security_state, TYPE3_SECURITY_STATE, type3_security_states) },
+    /* SMBIOS 2.3 and higher */
+    { FIELD_ABOVE (0x0D) },
+    { FIELD_NUM (smbios_type_3, oem_defined, TYPE3_OEM_DEFINED, "%-35s%s %.8X h\n") },
+};
+
+
+/*
+ * type 4 - processor information
+ */
+
+static const __u16 type4_types[] = {
+    [1] = STR_TYPE4_TYPE_OTHER,
+    [2] = STR_TYPE4_TYPE_UNKNOWN,
+    [3] = STR_TYPE4_TYPE_CENTRAL,
+    [4] = STR_TYPE4_TYPE_MATH,
+    [5] = STR_TYPE4_TYPE_DSP,
+    [6] = STR_TYPE4_TYPE_VIDEO,
+};
+static const __u16 type4_families[] = {
+    [1] = STR_TYPE4_FAMILY_OHTER,
+    [2] = STR_TYPE4_FAMILY_UNKNOWN,
+    [3] = STR_TYPE4_FAMILY_8086,
+    [4] = STR_TYPE4_FAMILY_80286,
+    [5] = STR_TYPE4_FAMILY_I386,
+    [6] = STR_TYPE4_FAMILY_I486,
+    [7] = STR_TYPE4_FAMILY_8087,
+    [8] = STR_TYPE4_FAMILY_80287,
+    [9] = STR_TYPE4_FAMILY_80387,
+    [10] = STR_TYPE4_FAMILY_80487,
+    [11] = STR_TYPE4_FAMILY_PENTIUM,
+    [12] = STR_TYPE4_FAMILY_PENTIUM_PRO,
+    [13] = STR_TYPE4_FAMILY_PENTIUM_II,
+    [14] = STR_TYPE4_FAMILY_PENTIUM_MMX,
+    [15] = STR_TYPE4_FAMILY_CELERON,
+    [16] = STR_TYPE4_FAMILY_PENTIUM_II_XEON,
+    [17] = STR_TYPE4_FAMILY_PENTIUM_III,
+    [18] = STR_TYPE4_FAMILY_M1,
+    [19] = STR_TYPE4_FAMILY_M2,
+    [20] = STR_TYPE4_FAMILY_M1_RES,
+    [21] = STR_TYPE4_FAMILY_M1_RES,
+    [22] = STR_TYPE4_FAMILY_M1_RES,
+    [23] = STR_TYPE4_FAMILY_M1_RES,
+    [24] = STR_TYPE4_FAMILY_DURON,
+    [25] = STR_TYPE4_FAMILY_K5,
+    [26] = STR_TYPE4_FAMILY_K6,
+    [27] = STR_TYPE4_FAMILY_K62,
+    [28] = STR_TYPE4_FAMILY_K63,
+    [29] = STR_TYPE4_FAMILY_ATHLON,
+    [30] = STR_TYPE4_FAMILY_29000,
+    [31] = STR_TYPE4_FAMILY_K62P,
+    [32] = STR_TYPE4_FAMILY_POWERPC,
+    [33] = STR_TYPE4_FAMILY_POWERPC_601,
+    [34] = STR_TYPE4_FAMILY_POWERPC_603,
+    [35] = STR_TYPE4_FAMILY_POWERPC_603P,
+    [36] = STR_TYPE4_FAMILY_POWERPC_604,
+    [37] = STR_TYPE4_FAMILY_POWERPC_620,
+    [38] = STR_TYPE4_FAMILY_POWERPC_X704,
+    [39] = STR_TYPE4_FAMILY_POWERPC_750,
+    [48] = STR_TYPE4_FAMILY_ALPHA,
+    [49] = STR_TYPE4_FAMILY_ALPHA_21064,
+    [50] = STR_TYPE4_FAMILY_ALPHA_21066,
+    [51] = STR_TYPE4_FAMILY_ALPHA_21164,
+    [52] = STR_TYPE4_FAMILY_ALPHA_21164PC,
+    [53] = STR_TYPE4_FAMILY_ALPHA_21164a,
+    [54] = STR_TYPE4_FAMILY_ALPHA_21264,
+    [55] = STR_TYPE4_FAMILY_ALPHA_21364,
+    [64] = STR_TYPE4_FAMILY_MIPS,
+    [65] = STR_TYPE4_FAMILY_MIPS_R4000,
+    [66] = STR_TYPE4_FAMILY_MIPS_R4200,
+    [67] = STR_TYPE4_FAMILY_MIPS_R4400,
+    [68] = STR_TYPE4_FAMILY_MIPS_R4600,
+    [69] = STR_TYPE4_FAMILY_MIPS_R10000,
+    [80] = STR_TYPE4_FAMILY_SPARC,
+    [81] = STR_TYPE4_FAMILY_SPARC_SUPER,
+    [82] = STR_TYPE4_FAMILY_SPARC_MICRO_II,
+    [83] = STR_TYPE4_FAMILY_SPARC_MICRO_IIEP,
+    [84] = STR_TYPE4_FAMILY_SPARC_ULTRA,
+    [85] = STR_TYPE4_FAMILY_SPARC_ULTRA_II,
+    [86] = STR_TYPE4_FAMILY_SPARC_ULTRA_II_I,
+    [87] = STR_TYPE4_FAMILY_SPARC_ULTRA_III,
+    [88] = STR_TYPE4_FAMILY_SPARC_ULTRA_III_I,
+    [96] = STR_TYPE4_FAMILY_68040,
+    [97] = STR_TYPE4_FAMILY_68XXX,
+    [98] = STR_TYPE4_FAMILY_68000,
+    [99] = STR_TYPE4_FAMILY_68010,
+    [100] = STR_TYPE4_FAMILY_68020,
+    [101] = STR_TYPE4_FAMILY_68030,
+    [112] = STR_TYPE4_FAMILY_HOBBIT,
+    [120] = STR_TYPE4_FAMILY_CRUSOE_TM5000,
+    [121] = STR_TYPE4_FAMILY_CRUSOE_TM3000,
+    [128] = STR_TYPE4_FAMILY_WEITEK,
+    [130] = STR_TYPE4_FAMILY_ITANIUM,
+    [144] = STR_TYPE4_FAMILY_PARISC,
+    [145] = STR_TYPE4_FAMILY_PARISC_8500,
+    [146] = STR_TYPE4_FAMILY_PARISC_8000,
+    [147] = STR_TYPE4_FAMILY_PARISC_7300LC,
+    [148] = STR_TYPE4_FAMILY_PARISC_7200,
+    [149] = STR_TYPE4_FAMILY_PARISC_7100LC,
+    [150] = STR_TYPE4_FAMILY_PARISC_7100,
+    [160] = STR_TYPE4_FAMILY_V30,
+    [176] = STR_TYPE4_FAMILY_PENTIUM_III_XEON,
+    [177] = STR_TYPE4_FAMILY_PENTIUM_III_SPEED,
+    [178] = STR_TYPE4_FAMILY_PENTIUM_4,
+    [180] = STR_TYPE4_FAMILY_AS400,
+    [200] = STR_TYPE4_FAMILY_IBM390,
+    [201] = STR_TYPE4_FAMILY_G4,
+    [202] = STR_TYPE4_FAMILY_G5,
+    [250] = STR_TYPE4_FAMILY_I860,
+    [251] = STR_TYPE4_FAMILY_I960,
+};
+static const __u16 type4_voltages[] = {
+    STR_TYPE4_VOLTAGE_50,
+    STR_TYPE4_VOLTAGE_33,
+    STR_TYPE4_VOLTAGE_29,
+};
+static const __u16 type4_status[] = {
+    [0] = STR_TYPE4_STATUS_UNKNOWN,
+    [1] = STR_TYPE4_STATUS_ENABLED,
+    [2] = STR_TYPE4_STATUS_DISABLED_USER,
+    [3] = STR_TYPE4_STATUS_DISABLED_POST,
+    [4] = STR_TYPE4_STATUS_IDLE,
+    [7] = STR_TYPE4_STATUS_OTHER,
+};
+
+static const __u16 type4_sockets[] = {
+    [0] = STR_TYPE4_SOCKET_UNPOPULATED,
+    [1] = STR_TYPE4_SOCKET_POPULATED,
+};
+
+static const __u16 type4_upgrades[] = {
+    [1] = STR_TYPE4_UPGRADE_OTHER,
+    [2] = STR_TYPE4_UPGRADE_UNKNOWN,
+    [3] = STR_TYPE4_UPGRADE_DAUGHTER,
+    [4] = STR_TYPE4_UPGRADE_ZIFF,
+    [5] = STR_TYPE4_UPGRADE_PIGGY_BACK,
+    [6] = STR_TYPE4_UPGRADE_NONE,
+    [7] = STR_TYPE4_UPGRADE_LIF,
+    [8] = STR_TYPE4_UPGRADE_SLOT1,
+    [9] = STR_TYPE4_UPGRADE_SLOT2,
+    [10] = STR_TYPE4_UPGRADE_370,
+    [11] = STR_TYPE4_UPGRADE_A,
+    [12] = STR_TYPE4_UPGRADE_M,
+    [13] = STR_TYPE4_UPGRADE_423,
+    [14] = STR_TYPE4_UPGRADE_A462,
+};
+
+/** \fn static void bios_cook_voltage (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+  * \brief renders the voltage of a processor
+  * \param render the output
+  * \param decoded the decoded Type 4 structure
+  * \param value the voltage
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * if bit 7 is set, the lower bits are the current voltage in 0.1V.
+  * otherwise they are the supported voltages.
   */
 
-unsigned char *
-bios_cook_type_4 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_cook_voltage (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
 {
-	smbios_type_4 *type4;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
+    const __u16 *names = (const __u16 *) value->field->names;
+    unsigned int voltage = value->number;
+    __u64 mask;
+    int bit;
 
-	/* contains one line of the above file */
-    unsigned char line[128];
 
-    int i;
-    unsigned char help[16];
-    unsigned char help2[16];
+    if (voltage & 0x80)
+    {
+        voltage &= 0x7F;
 
+        bios_printf (render, "%-35s%s %d.%dV\n", TYPE4_CURRENT_VOLTAGE, SEP1, voltage / 10, voltage % 10);
+        return;
+    }
 
-    /* cast our data ptr to a structure ptr of SMBIOS type 4 */
-    type4 = (smbios_type_4 *)smbiosstruct;
+    bios_printf (render, "%-35s%s\n", value->field->label, SEP1);
+    mask = bios_field_bits (value->field, voltage);
+    while ((bit = bios_next_bit (&mask)) >= 0)
+        bios_printf (render, "%-35s  %s %s\n", "", SEP2, SMBIOS_STRING (names[bit]));
+}
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE4_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
+static const smbios_field type_4_fields[] = {
+    { FIELD_STR (smbios_type_4, socket_designation, TYPE4_SOCKET_DESIGNATION) },
+    { FIELD_ENUM (smbios_type_4, type, TYPE4_TYPE, type4_types) },
+    { FIELD_ENUM (smbios_type_4, family, TYPE4_FAMILY, type4_families) },
+    { FIELD_STR (smbios_type_4, manufacturer, TYPE4_MANUFACTURER) },
+    { FIELD_HEX (smbios_type_4, id, TYPE4_ID) },
+    { FIELD_STR (smbios_type_4, version, TYPE4_VERSION) },
+    { FIELD_COOK (smbios_type_4, voltage, TYPE4_VOLTAGE, bios_cook_voltage), FIELD_NAMES (type4_voltages) },
+    { FIELD_NUM (smbios_type_4, external_clock, TYPE4_EXTERNAL_CLOCK, "%-35s%s %d " MHZ "\n"), FIELD_NAMES (smbios_hide_0) },
+    { FIELD_NUM (smbios_type_4, max_speed, TYPE4_MAX_SPEED, "%-35s%s %d " MHZ "\n"), FIELD_NAMES (smbios_hide_0) },
+    { FIELD_NUM (smbios_type_4, current_speed, TYPE4_CURRENT_SPEED, "%-35s%s %d " MHZ "\n"), FIELD_NAMES (smbios_hide_0) },
+    { FIELD_ENUM (smbios_type_4, status, TYPE4_STATUS, type4_status), mask: 0x07 },
+    { FIELD_ENUM (smbios_type_4, status, TYPE4_SOCKET, type4_sockets), mask: 0x40, shift: 6, flags: SMBIOS_FLAG_SAME },
+    { FIELD_ENUM (smbios_type_4, upgrade, TYPE4_UPGRADE, type4_upgrades) },
+    /* SMBIOS 2.1 and higher */
+    { FIELD_ABOVE (0x1A) },
+    { FIELD_HANDLE (smbios_type_4, l1_cache_handle, TYPE4_L1_CACHE_HANDLE), FIELD_NAMES (smbios_hide_ffff) },
+    { FIELD_HANDLE (smbios_type_4, l2_cache_handle, TYPE4_L2_CACHE_HANDLE), FIELD_NAMES (smbios_hide_ffff) },
+    { FIELD_HANDLE (smbios_type_4, l3_cache_handle, TYPE4_L3_CACHE_HANDLE), FIELD_NAMES (smbios_hide_ffff) },
+    /* SMBIOS 2.3 and higher */
+    { FIELD_ABOVE (0x20) },
+    { FIELD_STR (smbios_type_4, serialnumber, TYPE4_SERIAL_NUMBER) },
+    { FIELD_STR (smbios_type_4, asset_tag, TYPE4_ASSET_TAG) },
+    { FIELD_STR (smbios_type_4, part_number, TYPE4_PART_NUMBER) },
+};
 
 
+/*
+ * type 5 - memory controller information
+ */
 
-	sprintf (line, "%-35s%s %s\n", TYPE4_SOCKET_DESIGNATION, SEP1, GetString(smbiosstruct, (unsigned int)(type4->socket_designation)));
-	strcat(file, line);
+static const __u16 type5_error_detections[] = {
+    [1] = STR_TYPE5_ED_OTHER,
+    [2] = STR_TYPE5_ED_UNKNOWN,
+    [3] = STR_TYPE5_ED_NONE,
+    [4] = STR_TYPE5_ED_PARITY,
+    [5] = STR_TYPE5_ED_32ECC,
+    [6] = STR_TYPE5_ED_64ECC,
+    [7] = STR_TYPE5_ED_128ECC,
+    [8] = STR_TYPE5_ED_CRC,
+};
+static const __u16 type5_ecc[] = {
+    STR_TYPE5_ECC_OTHER,
+    STR_TYPE5_ECC_UNKNOWN,
+    STR_TYPE5_ECC_NONE,
+    STR_TYPE5_ECC_SINGLE_BIT,
+    STR_TYPE5_ECC_DOUBLE_BIT,
+    STR_TYPE5_ECC_SCRUBBING,
+};
+static const __u16 type5_interleaves[] = {
+    [1] = STR_TYPE5_I_OTHER,
+    [2] = STR_TYPE5_I_UNKNOWN,
+    [3] = STR_TYPE5_I_ONE_WAY,
+    [4] = STR_TYPE5_I_TWO_WAY,
+    [5] = STR_TYPE5_I_FOUR_WAY,
+    [6] = STR_TYPE5_I_EIGHT_WAY,
+    [7] = STR_TYPE5_I_SIXTEEN_WAY,
+};
+static const __u16 type5_speeds[] = {
+    STR_TYPE5_SSPEED_OTHER,
+    STR_TYPE5_SSPEED_UNKNOWN,
+    STR_TYPE5_SSPEED_70,
+    STR_TYPE5_SSPEED_60,
+    STR_TYPE5_SSPEED_50,
+};
+static const __u16 type5_memory_types[] = {
+    STR_TYPE5_ST_OTHER,
+    STR_TYPE5_ST_UNKNOWN,
+    STR_TYPE5_ST_STANDARD,
+    STR_TYPE5_ST_FAST_PAGE,
+    STR_TYPE5_ST_EDO,
+    STR_TYPE5_ST_PARITY,
+    STR_TYPE5_ST_ECC,
+    STR_TYPE5_ST_SIMM,
+    STR_TYPE5_ST_DIMM,
+    STR_TYPE5_ST_BURST_EDO,
+    STR_TYPE5_ST_SDRAM,
+};
+static const __u16 type5_voltages[] = {
+    STR_TYPE5_SV_50,
+    STR_TYPE5_SV_33,
+    STR_TYPE5_SV_29,
+};
+/** one memory module handle */
+static const smbios_field type5_handle_fields[] = {
+    { offset: 0, kind: SMBIOS_FIELD_INT, width: 2, show: SMBIOS_SHOW_NUMBER, flags: SMBIOS_FLAG_ITEM,
+      format: "%-35s  %s " HANDLE " %d \n" },
+};
+
+static const smbios_field type_5_fields[] = {
+    { FIELD_ENUM (smbios_type_5, error_detection, TYPE5_ERROR_DETECTION, type5_error_detections) },
+    { FIELD_BITS (smbios_type_5, ecc, TYPE5_ECC, type5_ecc) },
+    { FIELD_ENUM (smbios_type_5, supported_interleave, TYPE5_SUPPORTED_INTERLEAVE, type5_interleaves) },
+    { FIELD_ENUM (smbios_type_5, current_interleave, TYPE5_CURRENT_INTERLEAVE, type5_interleaves) },
+    { FIELD_NUM (smbios_type_5, max_mem_module_size, TYPE5_MAX_MEM_MOD_SIZE, "%-35s%s %d " MB "\n"), calc: SMBIOS_CALC_POW2 },
+    { FIELD_BITS (smbios_type_5, supported_speeds, TYPE5_SUPPORTED_SPEEDS, type5_speeds) },
+    { FIELD_BITS (smbios_type_5, supported_types, TYPE5_SUPPORTED_TYPES, type5_memory_types) },
+    { FIELD_BITS (smbios_type_5, voltage, TYPE5_SUPPORTED_VOLTAGES, type5_voltages) },
+    { FIELD_NUM (smbios_type_5, nr_assoc_slots, TYPE5_NR_ASSOC_SLOTS, "%-35s%s %d " TYPE5_SLOTS " \n") },
+    /* a handle for every slot */
+    { offset: sizeof (smbios_type_5), kind: SMBIOS_FIELD_LIST, width: 2, stride: 2, count: offsetof (smbios_type_5, nr_assoc_slots),
+      show: SMBIOS_SHOW_LIST, label: TYPE5_MEM_MOD_HANDLES, FIELD_NAMES (type5_handle_fields) },
+    /* enabled error correcting capabilities, SMBIOS 2.1 and higher */
+    { offset: 0, kind: SMBIOS_FIELD_INT | SMBIOS_FIELD_AFTER_LIST, width: 1, show: SMBIOS_SHOW_BITS,
+      label: TYPE5_ENABLED_ECC, FIELD_NAMES (type5_ecc) },
+};
+
+
+/*
+ * type 6 - memory module information
+ */
 
-	switch(type4->type)
-	{
-	    case 1:		sprintf (line, "%-35s%s %s\n", TYPE4_TYPE, SEP1, TYPE4_TYPE_OTHER);
-					break;
-		case 2:		sprintf (line, "%-35s%s %s\n", TYPE4_TYPE, SEP1, TYPE4_TYPE_UNKNOWN);
-					break;
-		case 3:		sprintf (line, "%-35s%s %s\n", TYPE4_TYPE, SEP1, TYPE4_TYPE_CENTRAL);
-					break;
-		case 4:		sprintf (line, "%-35s%s %s\n", TYPE4_TYPE, SEP1, TYPE4_TYPE_MATH);
-					break;
-		case 5:		sprintf (line, "%-35s%s %s\n", TYPE4_TYPE, SEP1, TYPE4_TYPE_DSP);
-					break;
-		case 6:		sprintf (line, "%-35s%s %s\n", TYPE4_TYPE, SEP1, TYPE4_TYPE_VIDEO);
-					break;
-		default:    sprintf (line, "%-35s%s %d\n", TYPE4_TYPE, SEP1, type4->type);
-	}
-	strcat(file, line);
+static const __u16 type6_memory_types[] = {
+    STR_TYPE6_CT_OTHER,
+    STR_TYPE6_CT_UNKNOWN,
+    STR_TYPE6_CT_STANDARD,
+    STR_TYPE6_CT_FAST_PAGE,
+    STR_TYPE6_CT_EDO,
+    STR_TYPE6_CT_PARITY,
+    STR_TYPE6_CT_ECC,
+    STR_TYPE6_CT_SIMM,
+    STR_TYPE6_CT_DIMM,
+    STR_TYPE6_CT_BURST_EDO,
+    STR_TYPE6_CT_SDRAM,
+};
+static const __u16 type6_banks[] = {
+    [0] = STR_TYPE6_S_SINGLE_BANK,
+    [1] = STR_TYPE6_S_DBL_BANK,
+};
+
+static const smbios_name type6_sizes[] = {
+    { 0x7D, STR_TYPE6_S_NOT_DETERMINABLE },
+    { 0x7E, STR_TYPE6_S_NOT_ENABLED },
+    { 0x7F, STR_TYPE6_S_NOT_INSTALLED },
+};
+
+static const __u16 type6_status[] = {
+    STR_TYPE6_STATUS_UNCORRECTABLE,
+    STR_TYPE6_STATUS_CORRECTABLE,
+    STR_TYPE6_STATUS_EVENTLOG,
+};
+
+/** \fn static void bios_cook_connection (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+  * \brief renders the RAS lines a memory module is connected to
+  * \param render the output
+  * \param decoded the decoded Type 6 structure
+  * \param value the connection
+  *
+  * each nibble is a RAS line, 0xF if there is none.
+  */
 
-    switch(type4->family)
-	{
-        case 1:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_OHTER);
-        			break;
-		case 2:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_UNKNOWN);
-					break;
-		case 3:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_8086);
-					break;
-		case 4:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_80286);
-					break;
-		case 5:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_I386);
-					break;
-		case 6:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_I486);
-					break;
-		case 7:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_8087);
-					break;
-		case 8:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_80287);
-					break;
-		case 9:		sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_80387);
-					break;
-		case 10:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_80487);
-					break;
-		case 11:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM);
-					break;
-		case 12:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_PRO);
-					break;
-		case 13:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_II);
-					break;
-		case 14:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_MMX);
-					break;
-		case 15:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_CELERON);
-					break;
-		case 16:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_II_XEON);
-					break;
-		case 17:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_III);
-					break;
-		case 18:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_M1);
-					break;
-		case 19:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_M2);
-					break;
-		case 20:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_M1_RES);
-					break;
-		case 21:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_M1_RES);
-					break;
-		case 22:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_M1_RES);
-					break;
-		case 23:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_M1_RES);
-					break;
-		case 24:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_DURON);
-					break;
-		case 25:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_K5);
-					break;
-		case 26:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_K6);
-					break;
-		case 27:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_K62);
-					break;
-		case 28:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_K63);
-					break;
-		case 29:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ATHLON);
-					break;
-		case 30:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_29000);
-					break;
-		case 31:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_K62P);
-					break;
-		case 32:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC);
-					break;
-		case 33:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_601);
-					break;
-		case 34:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_603);
-					break;
-		case 35:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_603P);
-					break;
-		case 36:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_604);
-					break;
-	    case 37:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_620);
-					break;
-		case 38:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_X704);
-					break;
-		case 39:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_POWERPC_750);
-					break;
-		case 48:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA);
-					break;
-		case 49:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21064);
-					break;
-		case 50:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21066);
-					break;
-		case 51:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21164);
-					break;
-		case 52:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21164PC);
-					break;
-		case 53:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21164a);
-					break;
-		case 54:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21264);
-					break;
-		case 55:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ALPHA_21364);
-					break;
-		case 64:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MIPS);
-					break;
-	    case 65:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MIPS_R4000);
-					break;
-		case 66:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MIPS_R4200);
-					break;
-		case 67:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MIPS_R4400);
-					break;
-		case 68:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MIPS_R4600);
-					break;
-		case 69:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MIPS_R10000);
-					break;
-		case 80:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC);
-					break;
-		case 81:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_SUPER);
-					break;
-	    case 82:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_MICRO_II);
-					break;
-		case 83:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_MICRO_IIEP);
-					break;
-		case 84:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_ULTRA);
-					break;
-		case 85:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_ULTRA_II);
-					break;
-		case 86:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_ULTRA_II_I);
-					break;
-		case 87:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_ULTRA_III);
-					break;
-		case 88:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SPARC_ULTRA_III_I);
-					break;
-		case 96:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_68040);
-					break;
-		case 97:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_68XXX);
-					break;
-		case 98:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_68000);
-					break;
-		case 99:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_68010);
-					break;
-		case 100:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_68020);
-					break;
-		case 101:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_68030);
-					break;
-		case 112:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_HOBBIT);
-					break;
-		case 120:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_CRUSOE_TM5000);
-					break;
-		case 121:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_CRUSOE_TM3000);
-					break;
-		case 128:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_WEITEK);
-					break;
-		case 130:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ITANIUM);
-					break;
-		case 144:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC);
-					break;
-		case 145:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC_8500);
-					break;
-		case 146:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC_8000);
-					break;
-		case 147:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC_7300LC);
-					break;
-		case 148:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC_7200);
-					break;
-		case 149:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC_7100LC);
-					break;
-		case 150:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PARISC_7100);
-					break;
-		case 160:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_V30);
-					break;
-		case 176:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_III_XEON);
-					break;
-	    case 177:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_III_SPEED);
-					break;
-	    case 178:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_PENTIUM_4);
-					break;
-		case 180:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_AS400);
-					break;
-		case 200:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_IBM390);
-					break;
-		case 201:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_G4);
-					break;
-		case 202:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_G5);
-					break;
-		case 250:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_I860);
-					break;
-		case 251:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_I960);
-					break;
-		case 260:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SH3);
-					break;
-		case 261:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_SH4);
-					break;
-		case 280:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_ARM);
-					break;
-		case 281:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_STRONG_ARM);
-					break;
-		case 300:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_6X86);
-					break;
-	    case 301:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MEDIAGX);
-					break;
-	    case 302:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_MII);
-					break;
-		case 320:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_WINCHIP);
-					break;
-		case 350:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_DSP);
-					break;
-	    case 500:	sprintf (line, "%-35s%s %s\n", TYPE4_FAMILY, SEP1, TYPE4_FAMILY_VIDEO);
-					break;
-        default:    sprintf (line, "%-35s%s %d\n", TYPE4_FAMILY, SEP1, type4->family);
-	}
-    strcat(file, line);
+static void
+bios_cook_connection (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+{
+    unsigned int connection = value->number;
 
-    sprintf (line, "%-35s%s %s\n", TYPE4_MANUFACTURER, SEP1, GetString(smbiosstruct, (unsigned int)(type4->manufacturer)));
-	strcat(file, line);
 
-    sprintf(line, "%-35s%s ", TYPE4_ID, SEP1);
-    strcat(file, line);
-    for (i=0; i<8; i++)
- 	{
-		sprintf(help, "%.2X ", (unsigned char)(type4->id[i]));
-        strcat(file, help);
-	}
-	strcat(file, "\n");
+    bios_printf (render, "%-35s%s ", value->field->label, SEP1);
 
-    sprintf (line, "%-35s%s %s\n", TYPE4_VERSION, SEP1, GetString(smbiosstruct, (unsigned int)(type4->version)));
-	strcat(file, line);
+    if ((connection & 0xF0) != 0xF0)
+        bios_printf (render, "%d", (connection & 0xF0) >> 4);
+    if ((connection & 0x0F) != 0x0F)
+        bios_printf (render, " & %d", connection & 0x0F);
+    bios_printf (render, "\n");
+}
 
-    if((type4->voltage) & 0x80)
-    {
-        if(((type4->voltage) & 0x7F) > 10)
-        {
-            sprintf(help, "%d", (type4->voltage) & 0x7F);
-            strncpy(help2, help, strlen(help)-1);
-            *(help2 + strlen(help)-1) = 0x00;
-        }
-        else
-        {
-            strcpy(help2, "0");
-        }
+static const smbios_field type_6_fields[] = {
+    { FIELD_STR (smbios_type_6, designation, TYPE6_SOCKET_DESIGNATION) },
+    { FIELD_COOK (smbios_type_6, connection, TYPE6_RAS, bios_cook_connection) },
+    { FIELD_NUM (smbios_type_6, current_speed, TYPE6_CURRENT_SPEED, "%-35s%s %d " NS " \n"), FIELD_NAMES (smbios_hide_0) },
+    { FIELD_BITS (smbios_type_6, current_type, TYPE6_CURRENT_TYPE, type6_memory_types) },
+    { FIELD_ENUM (smbios_type_6, installed_size, TYPE6_INSTALLED_SIZE, type6_banks), mask: 0x80, shift: 7,
+      flags: SMBIOS_FLAG_SPACE },
+    { FIELD_NUM (smbios_type_6, installed_size, TYPE6_INSTALLED_SIZE, "%-35s%s %d " MB "\n"), FIELD_NAMES (type6_sizes),
+      mask: 0x7F, calc: SMBIOS_CALC_POW2, flags: SMBIOS_FLAG_SPACE | SMBIOS_FLAG_SAME },
+    { FIELD_ENUM (smbios_type_6, enabled_size, TYPE6_ENABLED_SIZE, type6_banks), mask: 0x80, shift: 7,
+      flags: SMBIOS_FLAG_SPACE },
+    { FIELD_NUM (smbios_type_6, enabled_size, TYPE6_ENABLED_SIZE, "%-35s%s %d " MB "\n"), FIELD_NAMES (type6_sizes),
+      mask: 0x7F, calc: SMBIOS_CALC_POW2, flags: SMBIOS_FLAG_SPACE | SMBIOS_FLAG_SAME },
+    { FIELD_BITS (smbios_type_6, status, TYPE6_STATUS, type6_status) },
+};
+
+
+/*
+ * type 7 - cache information
+ */
 
-        strcat(help2, ".");
+static const __u16 type7_modes[] = {
+    [0] = STR_TYPE7_MODE_WT,
+    [1] = STR_TYPE7_MODE_WB,
+    [2] = STR_TYPE7_MODE_VAR,
+    [3] = STR_TYPE7_MODE_UNK,
+};
+static const __u16 type7_locations[] = {
+    [0] = STR_TYPE7_LOC_INT,
+    [1] = STR_TYPE7_LOC_EXT,
+    [2] = STR_TYPE7_LOC_RES,
+    [3] = STR_TYPE7_LOC_UNK,
+};
+static const __u16 type7_sram_types[] = {
+    STR_TYPE7_ST_OTHER,
+    STR_TYPE7_ST_UNKNOWN,
+    STR_TYPE7_ST_NON_BURST,
+    STR_TYPE7_ST_BURST,
+    STR_TYPE7_ST_PIPELINE_BURST,
+    STR_TYPE7_ST_SYNCHRONOUS,
+    STR_TYPE7_ST_ASYNCHRONOUS,
+};
+static const __u16 type7_ecc_types[] = {
+    [1] = STR_TYPE7_ECC_OTHER,
+    [2] = STR_TYPE7_ECC_UNKNOWN,
+    [3] = STR_TYPE7_ECC_NONE,
+    [4] = STR_TYPE7_ECC_PARITY,
+    [5] = STR_TYPE7_ECC_SINGLE_ECC,
+    [6] = STR_TYPE7_ECC_MULIT_ECC,
+};
+static const __u16 type7_cache_types[] = {
+    [1] = STR_TYPE7_TYPE_OTHER,
+    [2] = STR_TYPE7_TYPE_UNKNOWN,
+    [3] = STR_TYPE7_TYPE_INSTRUCTION,
+    [4] = STR_TYPE7_TYPE_DATA,
+    [5] = STR_TYPE7_TYPE_UNIFIED,
+};
+static const __u16 type7_associativities[] = {
+    [1] = STR_TYPE7_ASSOC_OTHER,
+    [2] = STR_TYPE7_ASSOC_UNKNOWN,
+    [3] = STR_TYPE7_ASSOC_DIREC_MAPPED,
+    [4] = STR_TYPE7_ASSOC_2WAY,
+    [5] = STR_TYPE7_ASSOC_4WAY,
+    [6] = STR_TYPE7_ASSOC_FULL,
+    [7] = STR_TYPE7_ASSOC_8WAY,
+    [8] = STR_TYPE7_ASSOC_16WAY,
+};
+static const smbios_field type_7_fields[] = {
+    { FIELD_STR (smbios_type_7, designation, TYPE7_SOCKET_DESIGNATION) },
+    { FIELD_ENUM (smbios_type_7, configuration, TYPE7_MODE, type7_modes), mask: 0x0300, shift: 8 },
+    { FIELD_ENUM (smbios_type_7, configuration, TYPE7_EN, smbios_booleans), mask: 0x0080, shift: 7,
+      flags: SMBIOS_FLAG_SAME },
+    { FIELD_ENUM (smbios_type_7, configuration, TYPE7_LOCATION, type7_locations), mask: 0x0060, shift: 5,
+      flags: SMBIOS_FLAG_SAME },
+    { FIELD_ENUM (smbios_type_7, configuration, TYPE7_SOCKETED, smbios_booleans), mask: 0x0008, shift: 3,
+      flags: SMBIOS_FLAG_SAME },
+    { FIELD_NUM (smbios_type_7, configuration, TYPE7_LEVEL, "%-35s%s %d\n"), mask: 0x0007, calc: SMBIOS_CALC_PLUS_1,
+      flags: SMBIOS_FLAG_SAME },
+    { FIELD_NUM (smbios_type_7, max_size, TYPE7_MAX_SIZE, "%-35s%s %d " KB "\n"), calc: SMBIOS_CALC_GRANULARITY },
+    { FIELD_NUM (smbios_type_7, installed_size, TYPE7_INST_SIZE, "%-35s%s %d " KB "\n"), calc: SMBIOS_CALC_GRANULARITY },
+    { FIELD_BITS (smbios_type_7, supported_sram, TYPE7_SUP_SRAM_TYPE, type7_sram_types) },
+    { FIELD_BITS (smbios_type_7, current_sram, TYPE7_CUR_SRAM_TYPE, type7_sram_types) },
+    /* SMBIOS 2.1 and higher */
+    { FIELD_ABOVE (0x0F) },
+    { FIELD_NUM (smbios_type_7, speed, TYPE7_SPEED, "%-35s%s %d " NS " \n"), FIELD_NAMES (smbios_hide_0) },
+    { FIELD_ENUM (smbios_type_7, ecc_type, TYPE7_ECC_TYPE, type7_ecc_types), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_ENUM (smbios_type_7, cache_type, TYPE7_CACHE_TYPE, type7_cache_types), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_ENUM (smbios_type_7, associativity, TYPE7_ASSOCIATIVITY, type7_associativities), flags: SMBIOS_FLAG_SPACE },
+};
 
-        if(((type4->voltage) & 0x7F) > 10)
-        {
-            strcat(help2, help + strlen(help)-1);
-        }
-        else
-        {
-            strcat(help2, help);
-        }
 
-        sprintf(line, "%-35s%s %sV\n", TYPE4_CURRENT_VOLTAGE, SEP1, help2);
-        strcat(file, line);
-    }
-    else
+/*
+ * type 8 - port connector information
+ */
+
+static const __u16 type8_connector_types[] = {
+    [0] = STR_TYPE8_CT_NONE,
+    [1] = STR_TYPE8_CT_CENTRONICS,
+    [2] = STR_TYPE8_CT_MINI_CENTRONICS,
+    [3] = STR_TYPE8_CT_PROPRIETARY,
+    [4] = STR_TYPE8_CT_DB25_MALE,
+    [5] = STR_TYPE8_CT_DB25_FEMALE,
+    [6] = STR_TYPE8_CT_DB15_MALE,
+    [7] = STR_TYPE8_CT_DB15_FEMALE,
+    [8] = STR_TYPE8_CT_DB9_MALE,
+    [9] = STR_TYPE8_CT_DB9_FEMALE,
+    [10] = STR_TYPE8_CT_RJ11,
+    [11] = STR_TYPE8_CT_RJ45,
+    [12] = STR_TYPE8_CT_MINI_SCSI,
+    [13] = STR_TYPE8_CT_MINI_DIN,
+    [14] = STR_TYPE8_CT_MICRO_DIN,
+    [15] = STR_TYPE8_CT_PS2,
+    [16] = STR_TYPE8_CT_INFRARED,
+    [17] = STR_TYPE8_CT_HPHIL,
+    [18] = STR_TYPE8_CT_USB,
+    [19] = STR_TYPE8_CT_SSA_SCSI,
+    [20] = STR_TYPE8_CT_DIN8_MALE,
+    [21] = STR_TYPE8_CT_DIN8_FEMALE,
+    [22] = STR_TYPE8_CT_ONBOARD_IDE,
+    [23] = STR_TYPE8_CT_ONBOARD_FLOPPY,
+    [24] = STR_TYPE8_CT_9PIN_DIL,
+    [25] = STR_TYPE8_CT_25PIN_DIL,
+    [26] = STR_TYPE8_CT_50PIN_DIL,
+    [27] = STR_TYPE8_CT_68PIN_DIL,
+    [28] = STR_TYPE8_CT_ONBOARD_SND_CD,
+    [29] = STR_TYPE8_CT_MINI_CENTRONICS_14,
+    [30] = STR_TYPE8_CT_MINI_CENTRONICS_26,
+    [31] = STR_TYPE8_CT_MINI_JACK_PHONES,
+    [32] = STR_TYPE8_CT_BNC,
+    [33] = STR_TYPE8_CT_1394,
+    [160] = STR_TYPE8_CT_PC98,
+    [161] = STR_TYPE8_CT_PC98HIRESO,
+    [162] = STR_TYPE8_CT_PCH98,
+    [163] = STR_TYPE8_CT_PC98NOTE,
+    [164] = STR_TYPE8_CT_PC98FULL,
+    [255] = STR_TYPE8_CT_OTHER,
+};
+static const __u16 type8_port_types[] = {
+    [0] = STR_TYPE8_TYPE_NONE,
+    [1] = STR_TYPE8_TYPE_PAR_XTAT,
+    [2] = STR_TYPE8_TYPE_PAR_PS2,
+    [3] = STR_TYPE8_TYPE_PAR_ECP,
+    [4] = STR_TYPE8_TYPE_PAR_EPP,
+    [5] = STR_TYPE8_TYPE_PAR_ECP_EPP,
+    [6] = STR_TYPE8_TYPE_SER_XTAT,
+    [7] = STR_TYPE8_TYPE_SER_16450,
+    [8] = STR_TYPE8_TYPE_SER_16550,
+    [9] = STR_TYPE8_TYPE_SER_16550A,
+    [10] = STR_TYPE8_TYPE_SCSI,
+    [11] = STR_TYPE8_TYPE_MIDI,
+    [12] = STR_TYPE8_TYPE_JOYSTICK,
+    [13] = STR_TYPE8_TYPE_KEYBOARD,
+    [14] = STR_TYPE8_TYPE_MOUSE,
+    [15] = STR_TYPE8_TYPE_SSA_SCSI,
+    [16] = STR_TYPE8_TYPE_USB,
+    [17] = STR_TYPE8_TYPE_1394,
+    [18] = STR_TYPE8_TYPE_PCMCIA_I,
+    [19] = STR_TYPE8_TYPE_PCMCIA_II,
+    [20] = STR_TYPE8_TYPE_PCMCIA_III,
+    [21] = STR_TYPE8_TYPE_CARDBUS,
+    [22] = STR_TYPE8_TYPE_ACCESSBUS,
+    [23] = STR_TYPE8_TYPE_SCSI_II,
+    [24] = STR_TYPE8_TYPE_SCSI_WIDE,
+    [25] = STR_TYPE8_TYPE_PC98,
+    [26] = STR_TYPE8_TYPE_PC98_HIRESO,
+    [27] = STR_TYPE8_TYPE_PCH98,
+    [28] = STR_TYPE8_TYPE_VIDEO,
+    [29] = STR_TYPE8_TYPE_AUDIO,
+    [30] = STR_TYPE8_TYPE_MODEM,
+    [31] = STR_TYPE8_TYPE_NET,
+    [160] = STR_TYPE8_TYPE_8251,
+    [161] = STR_TYPE8_TYPE_8251_FIFO,
+    [255] = STR_TYPE8_TYPE_OTHER,
+};
+static const smbios_field type_8_fields[] = {
+    { FIELD_STR (smbios_type_8, internal_designation, TYPE8_INT_REF_DESIGNATOR) },
+    { FIELD_ENUM (smbios_type_8, internal_type, TYPE8_INT_TYPE, type8_connector_types), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_STR (smbios_type_8, external_designation, TYPE8_EXT_REF_DESIGNATOR) },
+    { FIELD_ENUM (smbios_type_8, external_type, TYPE8_EXT_TYPE, type8_connector_types), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_ENUM (smbios_type_8, type, TYPE8_TYPE, type8_port_types), flags: SMBIOS_FLAG_SPACE },
+};
+
+
+/*
+ * type 9 - system slot information
+ */
+
+static const __u16 type9_types[] = {
+    [1] = STR_TYPE9_TYPE_OTHER,
+    [2] = STR_TYPE9_TYPE_UNKNOWN,
+    [3] = STR_TYPE9_TYPE_ISA,
+    [4] = STR_TYPE9_TYPE_MCA,
+    [5] = STR_TYPE9_TYPE_EISA,
+    [6] = STR_TYPE9_TYPE_PCI,
+    [7] = STR_TYPE9_TYPE_PCMCIA,
+    [8] = STR_TYPE9_TYPE_VL,
+    [9] = STR_TYPE9_TYPE_PROPRIETARY,
+    [10] = STR_TYPE9_TYPE_PROCESSOR,
+    [11] = STR_TYPE9_TYPE_MEMORY,
+    [12] = STR_TYPE9_TYPE_RISER,
+    [13] = STR_TYPE9_TYPE_NUBUS,
+    [14] = STR_TYPE9_TYPE_PCI66,
+    [15] = STR_TYPE9_TYPE_AGP,
+    [16] = STR_TYPE9_TYPE_AGP2,
+    [17] = STR_TYPE9_TYPE_AGP4,
+    [18] = STR_TYPE9_TYPE_PCI_X,
+    [160] = STR_TYPE9_TYPE_PC98_C20,
+    [161] = STR_TYPE9_TYPE_PC98_C24,
+    [162] = STR_TYPE9_TYPE_PC98_E,
+    [163] = STR_TYPE9_TYPE_PC98_LOCAL_BUS,
+    [164] = STR_TYPE9_TYPE_PC98_CARD,
+};
+static const __u16 type9_widths[] = {
+    [1] = STR_TYPE9_BW_OTHER,
+    [2] = STR_TYPE9_BW_UNKNOWN,
+    [3] = STR_TYPE9_BW_8,
+    [4] = STR_TYPE9_BW_16,
+    [5] = STR_TYPE9_BW_32,
+    [6] = STR_TYPE9_BW_64,
+    [7] = STR_TYPE9_BW_128,
+};
+static const __u16 type9_usages[] = {
+    [1] = STR_TYPE9_CU_OTHER,
+    [2] = STR_TYPE9_CU_UNKNOWN,
+    [3] = STR_TYPE9_CU_AVAILABLE,
+    [4] = STR_TYPE9_CU_IN_USE,
+};
+static const __u16 type9_lengths[] = {
+    [1] = STR_TYPE9_LENGTH_OTHER,
+    [2] = STR_TYPE9_LENGTH_UNKNOWN,
+    [3] = STR_TYPE9_LENGTH_SHORT,
+    [4] = STR_TYPE9_LENGTH_LONG,
+};
+static const __u16 type9_characteristics1[] = {
+    STR_TYPE9_CHAR_UNKNOWN,
+    STR_TYPE9_CHAR_5V,
+    STR_TYPE9_CHAR_33V,
+    STR_TYPE9_CHAR_SHARED,
+    STR_TYPE9_CHAR_PC_CARD_16,
+    STR_TYPE9_CHAR_CARDBUS,
+    STR_TYPE9_CHAR_ZOOM_VIDEO,
+    STR_TYPE9_CHAR_MODEM_RESUME,
+};
+static const __u16 type9_characteristics2[] = {
+    STR_TYPE9_CHAR_PME,
+    STR_TYPE9_CHAR_HOT_PLUG,
+    STR_TYPE9_CHAR_SMBUS,
+};
+
+/** \fn static void bios_cook_slot_id (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+  * \brief renders the slot id
+  * \param render the output
+  * \param decoded the decoded Type 9 structure
+  * \param value the slot id, id1 and id2
+  *
+  * the meaning of the two bytes of the slot id depends on the slot type.
+  */
+
+static void
+bios_cook_slot_id (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+{
+    const smbios_value *slot_type = bios_find_value (decoded, offsetof (smbios_type_9, type));
+    unsigned int type = slot_type ? slot_type->number : 0;
+    unsigned int id1 = value->number & 0xFF;
+    unsigned int id2 = value->number >> 8;
+
+
+    /* MCA and EISA */
+    if ((type == 0x04 || type == 0x05) && id1 > 0)
     {
-        sprintf (line, "%-35s%s\n", TYPE4_VOLTAGE, SEP1);
-	    strcat(file, line);
-        if(type4->voltage & 0x01)
-        {
-            sprintf (line, "%-35s  %s %s\n", "", SEP2, TYPE4_VOLTAGE_50);
-	        strcat(file, line);
-        }
-        if(type4->voltage & 0x02)
-        {
-            sprintf (line, "%-35s  %s %s\n", "", SEP2, TYPE4_VOLTAGE_33);
-	        strcat(file, line);
-		}
-        if(type4->voltage & 0x04)
-        {
-            sprintf (line, "%-35s  %s %s\n", "", SEP2, TYPE4_VOLTAGE_29);
-	        strcat(file, line);
-        }
+        bios_printf (render, "%-35s%s %d \n", type == 0x04 ? TYPE9_ID_MCA_SLOT_NR : TYPE9_ID_EISA_SLOT_NR, SEP1, id1);
     }
 
-    if(type4->external_clock > 0)
+    /* PCI, AGP and PCI-X */
+    if ((type >= 0x0F && type <= 0x12) || type == 0x06)
     {
-        sprintf (line, "%-35s%s %d %s\n", TYPE4_EXTERNAL_CLOCK, SEP1, type4->external_clock, MHZ);
-        strcat(file, line);
+        bios_printf (render, "%-35s%s %d \n", TYPE9_ID_PCI_SLOT_NR, SEP1, id1);
     }
 
-    if(type4->max_speed > 0)
+    /* PCMCIA */
+    if (type == 0x07)
     {
-        sprintf (line, "%-35s%s %d %s\n", TYPE4_MAX_SPEED, SEP1, type4->max_speed, MHZ);
-	    strcat(file, line);
+        bios_printf (render, "%-35s%s %d \n", TYPE9_ID_PCMCIA_ADAPTER_NR, SEP1, id1);
+        bios_printf (render, "%-35s%s %d \n", TYPE9_ID_PCMCIA_SOCKET_NR, SEP1, id2);
     }
-
-    if(type4->current_speed > 0)
-    {
-        sprintf (line, "%-35s%s %d %s\n", TYPE4_CURRENT_SPEED, SEP1, type4->current_speed, MHZ);
-	    strcat(file, line);
-    }
-
-    switch(type4->status &0x07)
-	{
-	    case 0:		sprintf (line, "%-35s%s %s\n", TYPE4_STATUS, SEP1, TYPE4_STATUS_UNKNOWN);
-					break;
-        case 1:		sprintf (line, "%-35s%s %s\n", TYPE4_STATUS, SEP1, TYPE4_STATUS_ENABLED);
-					break;
-        case 2:		sprintf (line, "%-35s%s %s\n", TYPE4_STATUS, SEP1, TYPE4_STATUS_DISABLED_USER);
-					break;
-		case 3:		sprintf (line, "%-35s%s %s\n", TYPE4_STATUS, SEP1, TYPE4_STATUS_DISABLED_POST);
-					break;
-	    case 4:		sprintf (line, "%-35s%s %s\n", TYPE4_STATUS, SEP1, TYPE4_STATUS_IDLE);
-					break;
-		case 7:		sprintf (line, "%-35s%s %s\n", TYPE4_STATUS, SEP1, TYPE4_STATUS_OTHER);
-					break;
-  	    default:    sprintf (line, "%-35s%s %d\n", TYPE4_STATUS, SEP1, type4->status &0x07);
-	}
-	strcat(file, line);
-
-    if(type4->status &0x40)
-        sprintf (line, "%-35s%s %s\n", TYPE4_SOCKET, SEP1, TYPE4_SOCKET_POPULATED);
-    else
-        sprintf (line, "%-35s%s %s\n", TYPE4_SOCKET, SEP1, TYPE4_SOCKET_UNPOPULATED);
-    strcat(file, line);
-
-    switch(type4->upgrade)
-	{
-        case 1:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_OTHER);
-					break;
-		case 2:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_UNKNOWN);
-					break;
-		case 3:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_DAUGHTER);
-					break;
-		case 4:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_ZIFF);
-					break;
-		case 5:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_PIGGY_BACK);
-					break;
-		case 6:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_NONE);
-					break;
-		case 7:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_LIF);
-					break;
-		case 8:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_SLOT1);
-					break;
-		case 9:		sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_SLOT2);
-					break;
-		case 10:	sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_370);
-					break;
-		case 11:	sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_A);
-					break;
-		case 12:	sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_M);
-					break;
-		case 13:	sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_423);
-			    	break;
-		case 14:	sprintf (line, "%-35s%s %s\n", TYPE4_UPGRADE, SEP1, TYPE4_UPGRADE_A462);
-					break;
-        default:    sprintf (line, "%-35s%s %d\n", TYPE4_UPGRADE, SEP1, type4->upgrade);
-	}
-	strcat(file, line);
-
-
-    /* SMBIOS 2.1 and higher */
-    if(smbiosstruct->length > 0x1A)
-    {
-        if(type4->l1_cache_handle != 0xFFFF)
-        {
-            sprintf(line, "%-35s%s %d\n", TYPE4_L1_CACHE_HANDLE, SEP1, type4->l1_cache_handle);
-            strcat(file, line);
-        }
-
-        if(type4->l2_cache_handle != 0xFFFF)
-        {
-            sprintf(line, "%-35s%s %d\n", TYPE4_L2_CACHE_HANDLE, SEP1, type4->l2_cache_handle);
-            strcat(file, line);
-        }
-
-        if(type4->l3_cache_handle != 0xFFFF)
-        {
-            sprintf(line, "%-35s%s %d\n", TYPE4_L3_CACHE_HANDLE, SEP1, type4->l3_cache_handle);
-            strcat(file, line);
-        }
-
-    }
-
-
-    /* SMBIOS 2.3 and higher */
-    if(smbiosstruct->length > 0x20)
-    {
-        sprintf (line, "%-35s%s %s\n", TYPE4_SERIAL_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type4->serialnumber)));
-  	    strcat(file, line);
-
-        sprintf (line, "%-35s%s %s\n", TYPE4_ASSET_TAG, SEP1, GetString(smbiosstruct, (unsigned int)(type4->asset_tag)));
-	    strcat(file, line);
-
-        sprintf (line, "%-35s%s %s\n", TYPE4_PART_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type4->part_number)));
-	    strcat(file, line);
-
-    }
-
-
-    /* now line contains a string with fully interpreted type 4 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
-
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
-
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
-
 }
 
+static const smbios_field type_9_fields[] = {
+    { FIELD_STR (smbios_type_9, designation, TYPE9_DESIGNATION) },
+    { FIELD_ENUM (smbios_type_9, type, TYPE9_TYPE, type9_types), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_ENUM (smbios_type_9, width, TYPE9_BUS_WIDTH, type9_widths), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_ENUM (smbios_type_9, usage, TYPE9_CURRENT_USAGE, type9_usages), flags: SMBIOS_FLAG_SPACE },
+    { FIELD_ENUM (smbios_type_9, length, TYPE9_LENGTH, type9_lengths), flags: SMBIOS_FLAG_SPACE },
+    /* slot id, id1 and id2 */
+    { offset: offsetof (smbios_type_9, id1), kind: SMBIOS_FIELD_INT, width: 2, show: SMBIOS_SHOW_COOK, label: TYPE9_ID,
+      cook: bios_cook_slot_id },
+    { FIELD_BITS (smbios_type_9, characteristics1, TYPE9_CHARACTERISTICS, type9_characteristics1) },
+    /* SMBIOS 2.1 and higher */
+    { FIELD_ABOVE (0x0C) },
+    { FIELD_BITS (smbios_type_9, characteristics2, NULL, type9_characteristics2) },
+};
 
-/** \fn unsigned char * bios_cook_type_5 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 5 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 5 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 5 (Memory Controller) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
-  */
-
-unsigned char *
-bios_cook_type_5 (smbios_struct * smbiosstruct, unsigned int *plength)
-{
-	smbios_type_5 *type5;
-    unsigned char * scratch;
-
-    /* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
-
-	/* contains one line of the above file */
-    unsigned char line[128];
-
-    unsigned char *ptr;
-    int i;
-
-
-    /* cast our data ptr to a structure ptr of SMBIOS type 5 */
-    type5 = (smbios_type_5 *)smbiosstruct;
-
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE5_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-
-    switch(type5->error_detection)
-	{
-	    case 1:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_OTHER);
-					break;
-        case 2:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_UNKNOWN);
-					break;
-        case 3:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_NONE);
-					break;
-        case 4:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_PARITY);
-					break;
-        case 5:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_32ECC);
-					break;
-        case 6:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_64ECC);
-					break;
-        case 7:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_128ECC);
-					break;
-        case 8:		sprintf (line, "%-35s%s %s\n", TYPE5_ERROR_DETECTION, SEP1, TYPE5_ED_CRC);
-					break;
-    	default:    sprintf (line, "%-35s%s %d\n", TYPE5_ERROR_DETECTION, SEP1, type5->error_detection);
-	}
-  	strcat(file, line);
-
-    sprintf(line, "%-35s%s\n", TYPE5_ECC, SEP1);
-    strcat(file, line);
-    if( (type5->ecc) & 0x01 )
-    {   sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_OTHER);
-        strcat(file, line);
-    }
-    if( (type5->ecc) & 0x02 )
-    {   sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type5->ecc) & 0x04 )
-    {   sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_NONE);
-        strcat(file, line);
-    }
-    if( (type5->ecc) & 0x08 )
-    {   sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_SINGLE_BIT);
-        strcat(file, line);
-    }
-    if( (type5->ecc) & 0x10 )
-    {   sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_DOUBLE_BIT);
-        strcat(file, line);
-    }
-    if( (type5->ecc) & 0x20 )
-    {   sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_SCRUBBING);
-        strcat(file, line);
-    }
-
-    switch(type5->supported_interleave)
-	{
-	    case 1:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_OTHER);
-					break;
-        case 2:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_UNKNOWN);
-					break;
-        case 3:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_ONE_WAY);
-					break;
-        case 4:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_TWO_WAY);
-					break;
-        case 5:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_FOUR_WAY);
-					break;
-        case 6:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_EIGHT_WAY);
-					break;
-        case 7:		sprintf (line, "%-35s%s %s\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, TYPE5_I_SIXTEEN_WAY);
-					break;
-    	default:    sprintf (line, "%-35s%s %d\n", TYPE5_SUPPORTED_INTERLEAVE, SEP1, type5->supported_interleave);
-	}
-  	strcat(file, line);
-
-    switch(type5->current_interleave)
-	{
-
-	    case 1:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_OTHER);
-					break;
-        case 2:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_UNKNOWN);
-					break;
-        case 3:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_ONE_WAY);
-					break;
-        case 4:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_TWO_WAY);
-					break;
-        case 5:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_FOUR_WAY);
-					break;
-        case 6:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_EIGHT_WAY);
-					break;
-        case 7:		sprintf (line, "%-35s%s %s\n", TYPE5_CURRENT_INTERLEAVE, SEP1, TYPE5_I_SIXTEEN_WAY);
-					break;
-    	default:    sprintf (line, "%-35s%s %d\n", TYPE5_CURRENT_INTERLEAVE, SEP1, type5->current_interleave);
-	}
-  	strcat(file, line);
-
-    sprintf(line, "%-35s%s %d %s\n", TYPE5_MAX_MEM_MOD_SIZE, SEP1, pow2(type5->max_mem_module_size), MB);
-    strcat(file, line);
-
-    sprintf(line, "%-35s%s\n", TYPE5_SUPPORTED_SPEEDS, SEP1);
-    strcat(file, line);
-    if( (type5->supported_speeds) & 0x01 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SSPEED_OTHER);
-        strcat(file, line);
-    }
-    if( (type5->supported_speeds) & 0x02 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SSPEED_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type5->supported_speeds) & 0x04 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SSPEED_70);
-        strcat(file, line);
-    }
-    if( (type5->supported_speeds) & 0x08 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SSPEED_60);
-        strcat(file, line);
-    }
-    if( (type5->supported_speeds) & 0x10 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SSPEED_50);
-        strcat(file, line);
-    }
-
-    sprintf(line, "%-35s%s\n", TYPE5_SUPPORTED_TYPES, SEP1);
-    strcat(file, line);
-    if( (type5->supported_types) & 0x0001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_OTHER);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_STANDARD);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_FAST_PAGE);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_EDO);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_PARITY);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_ECC);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0080 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_SIMM);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0100 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_DIMM);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0200 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_BURST_EDO);
-        strcat(file, line);
-    }
-    if( (type5->supported_types) & 0x0400 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ST_SDRAM);
-        strcat(file, line);
-    }
-
-    sprintf(line, "%-35s%s\n", TYPE5_SUPPORTED_VOLTAGES, SEP1);
-    strcat(file, line);
-    if( (type5->voltage) & 0x01 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SV_50);
-        strcat(file, line);
-    }
-    if( (type5->voltage) & 0x02 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SV_33);
-        strcat(file, line);
-    }
-    if( (type5->voltage) & 0x04 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_SV_29);
-        strcat(file, line);
-    }
 
-    sprintf(line, "%-35s%s %d %s \n", TYPE5_NR_ASSOC_SLOTS, SEP1, type5->nr_assoc_slots, TYPE5_SLOTS);
-    strcat(file, line);
+/*
+ * type 10 - onboard devices
+ */
 
-    ptr = (unsigned char *)smbiosstruct;
-    ptr += 0x0f;
+static const __u16 type10_status[] = {
+    [0] = STR_TYPE10_STATUS_DISABLED,
+    [1] = STR_TYPE10_STATUS_ENABLED,
+};
+
+static const __u16 type10_types[] = {
+    [1] = STR_TYPE10_TYPE_OTHER,
+    [2] = STR_TYPE10_TYPE_UNKNOWN,
+    [3] = STR_TYPE10_TYPE_VIDEO,
+    [4] = STR_TYPE10_TYPE_SCSI,
+    [5] = STR_TYPE10_TYPE_ETHERNET,
+    [6] = STR_TYPE10_TYPE_TOKEN_RING,
+    [7] = STR_TYPE10_TYPE_SOUND,
+};
+/** one device, smbios_type_10 has no header */
+static const smbios_field type10_device_fields[] = {
+    { show: SMBIOS_SHOW_INDEX, label: TYPE10_NR },
+    { FIELD_ENUM (smbios_type_10, type, TYPE10_STATUS, type10_status), mask: 0x80, shift: 7 },
+    { FIELD_ENUM (smbios_type_10, type, TYPE10_TYPE, type10_types), mask: 0x7F, flags: SMBIOS_FLAG_SAME },
+    { FIELD_STR (smbios_type_10, description, TYPE10_DEV_NAME), format: "%-35s%s %s\n\n" },
+};
+
+static const smbios_field type_10_fields[] = {
+    /* every device, up to the end of the structure */
+    { offset: SMBIOS_HEADER_LENGTH, kind: SMBIOS_FIELD_LIST, width: sizeof (smbios_type_10), stride: sizeof (smbios_type_10),
+      show: SMBIOS_SHOW_LIST, FIELD_NAMES (type10_device_fields) },
+};
+
+
+/*
+ * type 11 - oem strings, type 12 - system configuration options
+ */
 
-    sprintf(line, "%-35s%s \n", TYPE5_MEM_MOD_HANDLES, SEP1);
-    strcat(file, line);
-    for (i=0; i < (int)(type5->nr_assoc_slots); i++)
-    {
-        sprintf(line, "%-35s  %s %s %d \n", "", SEP2, HANDLE, (unsigned int)(*ptr));
-        strcat(file, line);
-        ptr += 2;
-    }
+static const smbios_field type_11_fields[] = {
+    { FIELD_AT (smbios_type_11, nr_of_strings), kind: SMBIOS_FIELD_INT },
+    { FIELD_STRINGS (smbios_type_11, nr_of_strings, TYPE11_NR) },
+};
 
+static const smbios_field type_12_fields[] = {
+    { FIELD_AT (smbios_type_12, nr_of_strings), kind: SMBIOS_FIELD_INT },
+    { FIELD_STRINGS (smbios_type_12, nr_of_strings, TYPE12_OPTION) },
+};
 
-    /* SMBIOS 2.1 and higher */
-    if( smbiosstruct->length == ((type5->nr_assoc_slots * 2) + 16) )
-    {
-        ptr = (unsigned char *) smbiosstruct;
-        ptr = ptr + ((type5->nr_assoc_slots * 2) + 0x0F);
 
-        sprintf(line, "%-35s%s\n", TYPE5_ENABLED_ECC, SEP1);
-        strcat(file, line);
-        if( (*ptr) & 0x01 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_OTHER);
-            strcat(file, line);
-        }
-        if( (*ptr) & 0x02 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_UNKNOWN);
-            strcat(file, line);
-        }
-        if( (*ptr) & 0x04 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_NONE);
-            strcat(file, line);
-        }
-        if( (*ptr) & 0x08 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_SINGLE_BIT);
-            strcat(file, line);
-        }
-        if( (*ptr) & 0x10 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_DOUBLE_BIT);
-            strcat(file, line);
-        }
-        if( (*ptr) & 0x20 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE5_ECC_SCRUBBING);
-            strcat(file, line);
-        }
-    }
-
-    /* now line contains a string with fully interpreted type 4 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
-
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+/*
+ * type 13 - bios language information
+ */
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+static const smbios_field type_13_fields[] = {
+    { FIELD_AT (smbios_type_13, nr_of_strings), kind: SMBIOS_FIELD_INT },
+    { FIELD_AT (smbios_type_13, flags), kind: SMBIOS_FIELD_INT },
+    { FIELD_STRINGS (smbios_type_13, nr_of_strings, TYPE13_SUP_LANG), flags: SMBIOS_FLAG_ITEM },
+    { FIELD_STR (smbios_type_13, current_language, TYPE13_CUR_LANG) },
+};
 
-}
 
+/*
+ * type 16 - physical memory array
+ */
 
-/** \fn unsigned char * bios_cook_type_6 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 6 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 6 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+static const __u16 type16_locations[] = {
+    [1] = STR_TYPE16_L_OTHER,
+    [2] = STR_TYPE16_L_UNKNOWN,
+    [3] = STR_TYPE16_L_MOTHERBOARD,
+    [4] = STR_TYPE16_L_ISA,
+    [5] = STR_TYPE16_L_EISA,
+    [6] = STR_TYPE16_L_PCI,
+    [7] = STR_TYPE16_L_MCA,
+    [8] = STR_TYPE16_L_PCMCIA,
+    [9] = STR_TYPE16_L_PRORIETARY,
+    [10] = STR_TYPE16_L_NUBUS,
+    [160] = STR_TYPE16_L_PC98C20,
+    [161] = STR_TYPE16_L_PC98C24,
+    [162] = STR_TYPE16_L_PC98E,
+    [163] = STR_TYPE16_L_PC98LOCAL,
+    [164] = STR_TYPE16_L_PC98CARD,
+};
+static const __u16 type16_uses[] = {
+    [1] = STR_TYPE16_USE_OTHER,
+    [2] = STR_TYPE16_USE_UNKNOWN,
+    [3] = STR_TYPE16_USE_SYSTEM,
+    [4] = STR_TYPE16_USE_VIDEO,
+    [5] = STR_TYPE16_USE_FLASH,
+    [6] = STR_TYPE16_USE_NON_VOLATILE,
+    [7] = STR_TYPE16_USE_CACHE,
+};
+static const __u16 type16_ecc_types[] = {
+    [1] = STR_TYPE16_ECC_OTHER,
+    [2] = STR_TYPE16_ECC_UNKNOWN,
+    [3] = STR_TYPE16_ECC_NONE,
+    [4] = STR_TYPE16_ECC_PARITY,
+    [5] = STR_TYPE16_ECC_SINGLE_ECC,
+    [6] = STR_TYPE16_ECC_DOUBLE_ECC,
+    [7] = STR_TYPE16_ECC_CRC,
+};
+static const smbios_name type16_error_handles[] = {
+    { 0xFFFE, STR_TYPE16_EH_NOT_SUPPORTED },
+    { 0xFFFF, STR_TYPE16_EH_NO_ERROR },
+};
+
+
+/** \fn static void bios_cook_capacity (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+  * \brief renders the maximum capacity of a memory array
+  * \param render the output
+  * \param decoded the decoded Type 16 structure
+  * \param value the capacity
   *
-  * this function gets a raw SMBIOS Type 6 (Memory Module) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the capacity is given in kB, it is unknown if bit 31 is set.
   */
 
-unsigned char *
-bios_cook_type_6 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_cook_capacity (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
 {
-	smbios_type_6 *type6;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
-
-	/* contains one line of the above file */
-    unsigned char line[128];
-
-
-    /* cast our data ptr to a structure ptr of SMBIOS type 6 */
-    type6 = (smbios_type_6 *)smbiosstruct;
-
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE6_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-	sprintf (line, "%-35s%s %s\n", TYPE6_SOCKET_DESIGNATION, SEP1, GetString(smbiosstruct, (unsigned int)(type6->designation)));
-	strcat(file, line);
-
-    sprintf(line, "%-35s%s ", TYPE6_RAS, SEP1);
-    strcat(file, line);
-    if( (type6->connection & 0xF0) != 0xF0 )
-    {
-        sprintf(line, "%d", (type6->connection & 0xF0) >> 4);
-        strcat(file, line);
-    }
-    if( (type6->connection & 0x0F) != 0x0F )
-    {
-        sprintf(line, " & %d", (type6->connection & 0x0F));
-        strcat(file, line);
-    }
-    strcat(file, "\n");
-
-    if(type6->current_speed > 0)
-    {
-        sprintf(line, "%-35s%s %d %s \n", TYPE6_CURRENT_SPEED, SEP1, type6->current_speed, NS);
-        strcat(file, line);
-    }
-    
-    sprintf(line, "%-35s%s\n", TYPE6_CURRENT_TYPE, SEP1);
-    strcat(file, line);
-    if( (type6->current_type) & 0x0001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_OTHER);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_STANDARD);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_FAST_PAGE);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_EDO);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_PARITY);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_ECC);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0080 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_SIMM);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0100 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_DIMM);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0200 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_BURST_EDO);
-        strcat(file, line);
-    }
-    if( (type6->current_type) & 0x0400 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_CT_SDRAM);
-        strcat(file, line);
-    }
+    unsigned int capacity = value->number;
 
-    if(type6->installed_size & 0x80)
-        sprintf(line, "%-35s%s %s \n", TYPE6_INSTALLED_SIZE, SEP1, TYPE6_S_DBL_BANK);
-    else
-        sprintf(line, "%-35s%s %s \n", TYPE6_INSTALLED_SIZE, SEP1, TYPE6_S_SINGLE_BANK);
-    strcat(file, line);
-    if((type6->installed_size & 0x7F) == 0x7F)
-    {
-        sprintf(line, "%-35s%s %s \n", TYPE6_INSTALLED_SIZE, SEP1, TYPE6_S_NOT_INSTALLED);
-        strcat(file, line);
-    }
-    if((type6->installed_size & 0x7F) == 0x7E)
-    {
-        sprintf(line, "%-35s%s %s \n", TYPE6_INSTALLED_SIZE, SEP1, TYPE6_S_NOT_ENABLED);
-        strcat(file, line);
-    }
-    if((type6->installed_size & 0x7F) == 0x7D)
-    {
-        sprintf(line, "%-35s%s %s \n", TYPE6_INSTALLED_SIZE, SEP1, TYPE6_S_NOT_DETERMINABLE);
-        strcat(file, line);
-    }
-
-    if((type6->installed_size & 0x7F) < 0x7D)
-    {
-        sprintf(line, "%-35s%s %d %s\n", TYPE6_INSTALLED_SIZE, SEP1, pow2(type6->installed_size & 0x7F), MB);
-        strcat(file, line);
-    }
 
-    if(type6->enabled_size & 0x80)
-        sprintf(line, "%-35s%s %s \n", TYPE6_ENABLED_SIZE, SEP1, TYPE6_S_DBL_BANK);
+    if (capacity & 0x80000000)
+        bios_printf (render, "%-35s%s %s\n", value->field->label, SEP1, TYPE16_MC_UNKNOWN);
     else
-        sprintf(line, "%-35s%s %s \n", TYPE6_ENABLED_SIZE, SEP1, TYPE6_S_SINGLE_BANK);
-    strcat(file, line);
-    if((type6->enabled_size & 0x7F) == 0x7F)
-    {
-        sprintf(line, "%-35s%s %s \n", TYPE6_ENABLED_SIZE, SEP1, TYPE6_S_NOT_INSTALLED);
-        strcat(file, line);
-    }
-    if((type6->enabled_size & 0x7F) == 0x7E)
-    {
-        sprintf(line, "%-35s%s %s \n", TYPE6_ENABLED_SIZE, SEP1, TYPE6_S_NOT_ENABLED);
-        strcat(file, line);
-    }
-
-    if((type6->enabled_size & 0x7F) == 0x7D)
-    {
-        sprintf(line, "%-35s%s %s \n", TYPE6_ENABLED_SIZE, SEP1, TYPE6_S_NOT_DETERMINABLE);
-        strcat(file, line);
-    }
-
-    if((type6->enabled_size & 0x7F) < 0x7D)
-    {
-        sprintf(line, "%-35s%s %d %s\n", TYPE6_ENABLED_SIZE, SEP1, pow2(type6->enabled_size & 0x7F), MB);
-        strcat(file, line);
-    }
-
-    sprintf(line, "%-35s%s\n", TYPE6_STATUS, SEP1);
-    strcat(file, line);
-    if( (type6->status) & 0x01 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_STATUS_UNCORRECTABLE);
-        strcat(file, line);
-    }
-    if( (type6->status) & 0x02 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_STATUS_CORRECTABLE);
-        strcat(file, line);
-    }
-    if( (type6->status) & 0x04 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE6_STATUS_EVENTLOG);
-        strcat(file, line);
-    }
-
-
-    /* now line contains a string with fully interpreted type 4 data */	
-	*plength = strlen(file);
-
-	/* allocate the memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
-
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
-
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */
-	return scratch;
+        bios_printf (render, "%-35s%s %d %s\n", value->field->label, SEP1, capacity, KB);
 }
 
+static const smbios_field type_16_fields[] = {
+    { FIELD_ENUM (smbios_type_16, location, TYPE16_LOCATION, type16_locations) },
+    { FIELD_ENUM (smbios_type_16, use, TYPE16_USE, type16_uses) },
+    { FIELD_ENUM (smbios_type_16, ecc, TYPE16_ECC, type16_ecc_types) },
+    { FIELD_COOK (smbios_type_16, max_capacity, TYPE16_MAX_CAPACITY, bios_cook_capacity) },
+    { FIELD_HANDLE (smbios_type_16, error_handle, TYPE16_ERROR_HANDLE), format: "%-35s%s " TYPE16_EH_HANDLE " %s\n",
+      FIELD_NAMES (type16_error_handles) },
+    { FIELD_NUM (smbios_type_16, nr_of_devices, TYPE16_NR_DEVICES, "%-35s%s %d\n") },
+};
 
-/** \fn unsigned char * bios_cook_type_7 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 7 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 7 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 7 (Cache) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
-  */
-
-unsigned char *
-bios_cook_type_7 (smbios_struct * smbiosstruct, unsigned int *plength)
-{
-	smbios_type_7 *type7;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
-
-	/* contains one line of the above file */
-    unsigned char line[128];
-
-
-    /* cast our data ptr to a structure ptr of SMBIOS type 7 */
-    type7 = (smbios_type_7 *)smbiosstruct;
-
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE7_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file,line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-	
-	/* prepare interpreted type 7 string */
-	sprintf (line, "%-35s%s %s\n", TYPE7_SOCKET_DESIGNATION, SEP1, GetString(smbiosstruct, (unsigned int)(type7->designation)));
- 	strcat(file, line);
- 	
-	switch( ((type7->configuration) & 0x0300) >> 8 )
-	{
-	    case 0:     sprintf (line, "%-35s%s %s\n", TYPE7_MODE, SEP1, TYPE7_MODE_WT);
-	                break;
-	    case 1:     sprintf (line, "%-35s%s %s\n", TYPE7_MODE, SEP1, TYPE7_MODE_WB);
-	                break;
-	    case 2:     sprintf (line, "%-35s%s %s\n", TYPE7_MODE, SEP1, TYPE7_MODE_VAR);
-	                break;
-	    case 3:     sprintf (line, "%-35s%s %s\n", TYPE7_MODE, SEP1, TYPE7_MODE_UNK);
-	                break;
-	    default:    sprintf (line, "%-35s%s %d\n", TYPE7_MODE, SEP1, ((type7->configuration) & 0x0300) >> 8);
- 	};
- 	strcat(file, line);
-
-	switch( ((type7->configuration) & 0x0080) >> 7 )
-	{
-	    case 0:     sprintf (line, "%-35s%s %s\n", TYPE7_EN, SEP1, SMB_FALSE);
-	                break;
-	    case 1:     sprintf (line, "%-35s%s %s\n", TYPE7_EN, SEP1, SMB_TRUE);
-	                break;
-	    default:    sprintf (line, "%-35s%s %d\n", TYPE7_EN, SEP1, ((type7->configuration) & 0x0080) >> 7);
- 	};
- 	strcat(file, line);
-
-	switch( ((type7->configuration) & 0x0060) >> 5 )
-	{
-	    case 0:     sprintf (line, "%-35s%s %s\n", TYPE7_LOCATION, SEP1, TYPE7_LOC_INT);
-	                break;
-	    case 1:     sprintf (line, "%-35s%s %s\n", TYPE7_LOCATION, SEP1, TYPE7_LOC_EXT);
-	                break;
-	    case 2:     sprintf (line, "%-35s%s %s\n", TYPE7_LOCATION, SEP1, TYPE7_LOC_RES);
-	                break;
-	    case 3:     sprintf (line, "%-35s%s %s\n", TYPE7_LOCATION, SEP1, TYPE7_LOC_UNK);
-	                break;
-        default:    sprintf (line, "%-35s%s %d\n", TYPE7_LOCATION, SEP1, ((type7->configuration) & 0x0060) >> 5);	
- 	};
- 	strcat(file, line);
-
-	switch( ((type7->configuration) & 0x0008) >> 3 )
-	{
-	    case 0:     sprintf (line, "%-35s%s %s\n", TYPE7_SOCKETED, SEP1, SMB_FALSE);
-	                break;
-	    case 1:     sprintf (line, "%-35s%s %s\n", TYPE7_SOCKETED, SEP1, SMB_TRUE);
-	                break;
-	    default:    sprintf (line, "%-35s%s %d\n", TYPE7_SOCKETED, SEP1, ((type7->configuration) & 0x0008) >> 3);
- 	};
- 	strcat(file, line);
- 	
- 	sprintf (line, "%-35s%s %d\n", TYPE7_LEVEL, SEP1, ((type7->configuration) & 0x0007) + 1 );
- 	strcat(file, line);
- 	
- 	if((type7->max_size) & 0x8000)
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE7_MAX_SIZE, SEP1, ((type7->max_size) & 0x7FFF) * 64, KB);
- 	else
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE7_MAX_SIZE, SEP1, (type7->max_size) & 0x7FFF, KB);
- 	strcat(file, line);
-
- 	if((type7->installed_size) & 0x8000)
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE7_INST_SIZE, SEP1, ((type7->installed_size) & 0x7FFF) * 64, KB);
- 	else
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE7_INST_SIZE, SEP1, (type7->installed_size) & 0x7FFF, KB);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s\n", TYPE7_SUP_SRAM_TYPE, SEP1);
- 	strcat(file, line);
-    if( (type7->supported_sram) & 0x0001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_OTHER);
-        strcat(file, line);
-    }
-    if( (type7->supported_sram) & 0x0002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type7->supported_sram) & 0x0004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_NON_BURST);
-        strcat(file, line);
-    }
-    if( (type7->supported_sram) & 0x0008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_BURST);
-        strcat(file, line);
-    }
-    if( (type7->supported_sram) & 0x0010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_PIPELINE_BURST);
-        strcat(file, line);
-    }
-    if( (type7->supported_sram) & 0x0020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_SYNCHRONOUS);
-        strcat(file, line);
-    }
-    if( (type7->supported_sram) & 0x0040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_ASYNCHRONOUS);
-        strcat(file, line);
-    }
- 	
- 	sprintf(line, "%-35s%s\n", TYPE7_CUR_SRAM_TYPE, SEP1);
- 	strcat(file, line);
-    if( (type7->current_sram) & 0x0001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_OTHER);
-        strcat(file, line);
-    }
-    if( (type7->current_sram) & 0x0002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type7->current_sram) & 0x0004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_NON_BURST);
-        strcat(file, line);
-    }
-    if( (type7->current_sram) & 0x0008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_BURST);
-        strcat(file, line);
-    }
-    if( (type7->current_sram) & 0x0010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_PIPELINE_BURST);
-        strcat(file, line);
-    }
-    if( (type7->current_sram) & 0x0020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_SYNCHRONOUS);
-        strcat(file, line);
-    }
-    if( (type7->current_sram) & 0x0040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE7_ST_ASYNCHRONOUS);
-        strcat(file, line);
-    }
- 	 	 	 	
-
-    /* if smbios 2.1 or higher */
-    if(smbiosstruct->length > 0x0F)		
-	{
-	    if(type7->speed > 0)
-	    {
-	        sprintf(line, "%-35s%s %d %s \n", TYPE7_SPEED, SEP1, type7->speed, NS);
-	        strcat(file, line);
-	    }
-	
-	    switch(type7->ecc_type)
-	    {
-	        case 1:     sprintf(line, "%-35s%s %s \n", TYPE7_ECC_TYPE, SEP1, TYPE7_ECC_OTHER);
-	                    break;
-	        case 2:     sprintf(line, "%-35s%s %s \n", TYPE7_ECC_TYPE, SEP1, TYPE7_ECC_UNKNOWN);
-	                    break;
-	        case 3:     sprintf(line, "%-35s%s %s \n", TYPE7_ECC_TYPE, SEP1, TYPE7_ECC_NONE);
-	                    break;
-	        case 4:     sprintf(line, "%-35s%s %s \n", TYPE7_ECC_TYPE, SEP1, TYPE7_ECC_PARITY);
-	                    break;
-	        case 5:     sprintf(line, "%-35s%s %s \n", TYPE7_ECC_TYPE, SEP1, TYPE7_ECC_SINGLE_ECC);
-	                    break;
-	        case 6:     sprintf(line, "%-35s%s %s \n", TYPE7_ECC_TYPE, SEP1, TYPE7_ECC_MULIT_ECC);
-	                    break;
-	        default:    sprintf(line, "%-35s%s %d \n", TYPE7_ECC_TYPE, SEP1, type7->ecc_type);
-	    }
-	    strcat(file, line);
-	
-	    switch(type7->cache_type)
-	    {
-	        case 1:     sprintf(line, "%-35s%s %s \n", TYPE7_CACHE_TYPE, SEP1, TYPE7_TYPE_OTHER);
-	                    break;
-	        case 2:     sprintf(line, "%-35s%s %s \n", TYPE7_CACHE_TYPE, SEP1, TYPE7_TYPE_UNKNOWN);
-	                    break;
-	        case 3:     sprintf(line, "%-35s%s %s \n", TYPE7_CACHE_TYPE, SEP1, TYPE7_TYPE_INSTRUCTION);
-	                    break;
-	        case 4:     sprintf(line, "%-35s%s %s \n", TYPE7_CACHE_TYPE, SEP1, TYPE7_TYPE_DATA);
-	                    break;
-	        case 5:     sprintf(line, "%-35s%s %s \n", TYPE7_CACHE_TYPE, SEP1, TYPE7_TYPE_UNIFIED);
-	                    break;
-	        default:    sprintf(line, "%-35s%s %d \n", TYPE7_CACHE_TYPE, SEP1, type7->cache_type);
-	    }
-	    strcat(file, line);
 
-	    switch(type7->associativity)
-	    {
-	        case 1:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_OTHER);
-	                    break;
-	        case 2:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_UNKNOWN);
-	                    break;
-	        case 3:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_DIREC_MAPPED);
-	                    break;
-	        case 4:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_2WAY);
-	                    break;
-	        case 5:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_4WAY);
-	                    break;
-	        case 6:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_FULL);
-	                    break;
-	        case 7:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_8WAY);
-	                    break;
-	        case 8:     sprintf(line, "%-35s%s %s \n", TYPE7_ASSOCIATIVITY, SEP1, TYPE7_ASSOC_16WAY);
-	                    break;
-	        default:    sprintf(line, "%-35s%s %d \n", TYPE7_ASSOCIATIVITY, SEP1, type7->associativity);
-	    }
-	    strcat(file, line);
-	    	
-	} /* end - if smbios 2.1 or higher */
-
-	/* now line contains a string with fully interpreted type 1 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
-
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
-
-	/* return a string with all the interpreted data for the given raw structure. */	
-    /* the caller is responsible to free the memory. */	
-    return scratch;
-
-}
-
-
-/** \fn unsigned char * bios_cook_type_8 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 8 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 8 raw structure
+/*
+ * type 17 - memory device
+ */
 
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 8 (Port Connector) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+static const smbios_name type17_error_handles[] = {
+    { 0xFFFE, STR_TYPE17_EH_NOT_SUPPORTED },
+    { 0xFFFF, STR_TYPE17_EH_NO_ERROR },
+};
+
+static const smbios_name type17_total_widths[] = {
+    { 0xFFFF, STR_TYPE17_TW_UNKNOWN },
+};
+
+static const smbios_name type17_data_widths[] = {
+    { 0xFFFF, STR_TYPE17_DW_UNKNOWN },
+};
+
+static const smbios_name type17_sizes[] = {
+    { 0,      STR_TYPE17_SIZE_NOT_INSTALLED },
+    { 0xFFFF, STR_TYPE17_SIZE_UNKNOWN },
+};
+
+static const __u16 type17_form_factors[] = {
+    [1] = STR_TYPE17_FF_OTHER,
+    [2] = STR_TYPE17_FF_UNKNOWN,
+    [3] = STR_TYPE17_FF_SIMM,
+    [4] = STR_TYPE17_FF_SIP,
+    [5] = STR_TYPE17_FF_CHIP,
+    [6] = STR_TYPE17_FF_DIP,
+    [7] = STR_TYPE17_FF_ZIP,
+    [8] = STR_TYPE17_FF_PROPRIETARY,
+    [9] = STR_TYPE17_FF_DIMM,
+    [10] = STR_TYPE17_FF_TSOP,
+    [11] = STR_TYPE17_FF_ROW,
+    [12] = STR_TYPE17_FF_RIMM,
+    [13] = STR_TYPE17_FF_SODIMM,
+    [14] = STR_TYPE17_FF_SRIMM,
+};
+static const smbios_name type17_device_sets[] = {
+    { 0,    STR_TYPE17_DEVICE_SET_NOT_IN_SET },
+    { 0xFF, STR_TYPE17_DEVICE_SET_UNKONWN },
+};
+
+static const __u16 type17_memory_types[] = {
+    [1] = STR_TYPE17_MT_OTHER,
+    [2] = STR_TYPE17_MT_UNKNOWN,
+    [3] = STR_TYPE17_MT_DRAM,
+    [4] = STR_TYPE17_MT_EDRAM,
+    [5] = STR_TYPE17_MT_VRAM,
+    [6] = STR_TYPE17_MT_SRAM,
+    [7] = STR_TYPE17_MT_RAM,
+    [8] = STR_TYPE17_MT_ROM,
+    [9] = STR_TYPE17_MT_FLASH,
+    [10] = STR_TYPE17_MT_EEPROM,
+    [11] = STR_TYPE17_MT_FEPROM,
+    [12] = STR_TYPE17_MT_EPROM,
+    [13] = STR_TYPE17_MT_CDRAM,
+    [14] = STR_TYPE17_MT_3DRAM,
+    [15] = STR_TYPE17_MT_SDRAM,
+    [16] = STR_TYPE17_MT_SGRAM,
+    [17] = STR_TYPE17_MT_RDRAM,
+    [18] = STR_TYPE17_MT_DDR,
+};
+static const __u16 type17_type_details[] = {
+    STR_TYPE17_TD_RESERVED,
+    STR_TYPE17_TD_OTHER,
+    STR_TYPE17_TD_UNKNOWN,
+    STR_TYPE17_TD_FAST_PAGE,
+    STR_TYPE17_TD_STATIC_COLUMN,
+    STR_TYPE17_TD_PSEUDO_STATIC,
+    STR_TYPE17_TD_RAMBUS,
+    STR_TYPE17_TD_SYNCHRONOUS,
+    STR_TYPE17_TD_CMOS,
+    STR_TYPE17_TD_EDO,
+    STR_TYPE17_TD_WINDOW_DRAM,
+    STR_TYPE17_TD_CACHE_DRAM,
+    STR_TYPE17_TD_NON_VOLATILE,
+};
+
+/** \fn static void bios_cook_device_size (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+  * \brief renders the size of a memory device
+  * \param render the output
+  * \param decoded the decoded Type 17 structure
+  * \param value the size
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the size is given in kB if bit 15 is set, otherwise in MB.
   */
 
-unsigned char *
-bios_cook_type_8 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_cook_device_size (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
 {
-	smbios_type_8 *type8;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-	unsigned char file[2800];
-
-	/* contains one line of the above file */
-    unsigned char line[128];
-
-
-    /* cast our data ptr to a structure ptr of SMBIOS type 8 */
-    type8 = (smbios_type_8 *)smbiosstruct;
-
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE8_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
+    unsigned int size = value->number;
+    const smbios_name *name = bios_find_name (value->field, size);
 
 
-	/* prepare interpreted type 8 strings */
-	sprintf (line, "%-35s%s %s\n", TYPE8_INT_REF_DESIGNATOR, SEP1, GetString(smbiosstruct, (unsigned int)(type8->internal_designation)));
- 	strcat(file, line);
-
-    switch(type8->internal_type)
-	{
-	    case 0:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_NONE);
-	                break;
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_CENTRONICS);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MINI_CENTRONICS);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PROPRIETARY);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DB25_MALE);
-	                break;
-	    case 5:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DB25_FEMALE);
-	                break;
-        case 6:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DB15_MALE);
-	                break;
-        case 7:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DB15_FEMALE);
-	                break;
-        case 8:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DB9_MALE);
-	                break;
-        case 9:     sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DB9_FEMALE);
-	                break;
-        case 10:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_RJ11);
-	                break;
-        case 11:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_RJ45);
-	                break;
-        case 12:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MINI_SCSI);
-	                break;
-        case 13:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MINI_DIN);
-	                break;
-        case 14:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MICRO_DIN);
-	                break;
-        case 15:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PS2);
-	                break;
-        case 16:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_INFRARED);
-	                break;
-        case 17:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_HPHIL);
-                    break;
-        case 18:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_USB);
-	                break;
-        case 19:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_SSA_SCSI);
-	                break;
-        case 20:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DIN8_MALE);
-	                break;
-        case 21:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_DIN8_FEMALE);
-	                break;
-        case 22:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_ONBOARD_IDE);
-	                break;
-        case 23:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_ONBOARD_FLOPPY);
-	                break;
-        case 24:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_9PIN_DIL);
-	                break;
-        case 25:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_25PIN_DIL);
-	                break;
-        case 26:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_50PIN_DIL);
-	                break;
-        case 27:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_68PIN_DIL);
-	                break;
-        case 28:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_ONBOARD_SND_CD);
-	                break;
-        case 29:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MINI_CENTRONICS_14);
-	                break;
-        case 30:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MINI_CENTRONICS_26);
-	                break;
-        case 31:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_MINI_JACK_PHONES);
-	                break;
-        case 32:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_BNC);
-	                break;
-        case 33:    sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_1394);
-	                break;
-        case 160:   sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PC98);
-	                break;
-        case 161:   sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PC98HIRESO);
-	                break;
-        case 162:   sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PCH98);
-	                break;
-        case 163:   sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PC98NOTE);
-	                break;
-        case 164:   sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_PC98FULL);
-	                break;
-        case 255:   sprintf(line, "%-35s%s %s \n", TYPE8_INT_TYPE, SEP1, TYPE8_CT_OTHER);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE8_INT_TYPE, SEP1, type8->internal_type);
-	}
-	strcat(file, line);
-
-	sprintf (line, "%-35s%s %s\n", TYPE8_EXT_REF_DESIGNATOR, SEP1, GetString(smbiosstruct, (unsigned int)(type8->external_designation)));
- 	strcat(file, line);
-
-    switch(type8->external_type)
-	{
-	    case 0:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_NONE);
-	                break;
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_CENTRONICS);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MINI_CENTRONICS);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PROPRIETARY);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DB25_MALE);
-	                break;
-	    case 5:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DB25_FEMALE);
-	                break;
-        case 6:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DB15_MALE);
-	                break;
-        case 7:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DB15_FEMALE);
-	                break;
-        case 8:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DB9_MALE);
-	                break;
-        case 9:     sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DB9_FEMALE);
-	                break;
-        case 10:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_RJ11);
-	                break;
-        case 11:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_RJ45);
-	                break;
-        case 12:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MINI_SCSI);
-	                break;
-        case 13:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MINI_DIN);
-	                break;
-        case 14:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MICRO_DIN);
-	                break;
-        case 15:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PS2);
-	                break;
-        case 16:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_INFRARED);
-	                break;
-        case 17:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_HPHIL);
-	                break;
-        case 18:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_USB);
-	                break;
-        case 19:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_SSA_SCSI);
-	                break;
-        case 20:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DIN8_MALE);
-	                break;
-        case 21:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_DIN8_FEMALE);
-	                break;
-        case 22:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_ONBOARD_IDE);
-	                break;
-        case 23:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_ONBOARD_FLOPPY);
-	                break;
-        case 24:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_9PIN_DIL);
-	                break;
-        case 25:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_25PIN_DIL);
-	                break;
-        case 26:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_50PIN_DIL);
-	                break;
-        case 27:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_68PIN_DIL);
-	                break;
-        case 28:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_ONBOARD_SND_CD);
-	                break;
-        case 29:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MINI_CENTRONICS_14);
-	                break;
-        case 30:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MINI_CENTRONICS_26);
-	                break;
-        case 31:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_MINI_JACK_PHONES);
-	                break;
-        case 32:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_BNC);
-	                break;
-        case 33:    sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_1394);
-	                break;
-        case 160:   sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PC98);
-	                break;
-        case 161:   sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PC98HIRESO);
-	                break;
-        case 162:   sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PCH98);
-	                break;
-        case 163:   sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PC98NOTE);
-	                break;
-        case 164:   sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_PC98FULL);
-	                break;
-        case 255:   sprintf(line, "%-35s%s %s \n", TYPE8_EXT_TYPE, SEP1, TYPE8_CT_OTHER);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE8_EXT_TYPE, SEP1, type8->external_type);
-	}
-	strcat(file, line);
-
-    switch(type8->type)
-	{
-	    case 0:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_NONE);
-	                break;
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PAR_XTAT);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PAR_PS2);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PAR_ECP);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PAR_EPP);
-	                break;
-	    case 5:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PAR_ECP_EPP);
-	                break;
-        case 6:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SER_XTAT);
-	                break;
-        case 7:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SER_16450);
-	                break;
-        case 8:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SER_16550);
-	                break;
-        case 9:     sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SER_16550A);
-	                break;
-        case 10:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SCSI);
-	                break;
-        case 11:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_MIDI);
-	                break;
-        case 12:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_JOYSTICK);
-	                break;
-        case 13:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_KEYBOARD);
-	                break;
-        case 14:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_MOUSE);
-	                break;
-        case 15:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SSA_SCSI);
-	                break;
-        case 16:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_USB);
-	                break;
-        case 17:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_1394);
-	                break;
-        case 18:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PCMCIA_I);
-	                break;
-        case 19:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PCMCIA_II);
-	                break;
-        case 20:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PCMCIA_III);
-	                break;
-        case 21:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_CARDBUS);
-	                break;
-        case 22:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_ACCESSBUS);
-	                break;
-        case 23:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SCSI_II);
-	                break;
-        case 24:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_SCSI_WIDE);
-	                break;
-        case 25:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PC98);
-	                break;
-        case 26:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PC98_HIRESO);
-	                break;
-        case 27:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_PCH98);
-	                break;
-        case 28:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_VIDEO);
-	                break;
-        case 29:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_AUDIO);
-	                break;
-        case 30:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_MODEM);
-	                break;
-        case 31:    sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_NET);
-	                break;
-        case 160:   sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_8251);
-	                break;
-        case 161:   sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_8251_FIFO);
-	                break;
-        case 255:   sprintf(line, "%-35s%s %s \n", TYPE8_TYPE, SEP1, TYPE8_TYPE_OTHER);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE8_TYPE, SEP1, type8->type);
-	}
-	strcat(file, line);
-
-
-    /* now line contains a string with fully interpreted type 8 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
-
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
-
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+    if (name)
+        bios_printf (render, "%-35s%s %s\n", value->field->label, SEP1, SMBIOS_STRING (name->name));
+    else if (size & 0x8000)
+        bios_printf (render, "%-35s%s %d %s\n", value->field->label, SEP1, size & 0x7FFF, KB);
+    else
+        bios_printf (render, "%-35s%s %d %s\n", value->field->label, SEP1, size, MB);
 }
 
+static const smbios_field type_17_fields[] = {
+    { FIELD_HANDLE (smbios_type_17, memory_array_handle, TYPE17_MEM_ARRAY_HANDLE) },
+    { FIELD_HANDLE (smbios_type_17, error_handle, TYPE17_ERROR_HANDLE), format: "%-35s%s " TYPE17_EH_HANDLE " %s\n",
+      FIELD_NAMES (type17_error_handles) },
+    { FIELD_NUM (smbios_type_17, total_width, TYPE17_TOTAL_WIDTH, "%-35s%s %d " BIT "\n"), FIELD_NAMES (type17_total_widths) },
+    { FIELD_NUM (smbios_type_17, data_width, TYPE17_DATA_WIDTH, "%-35s%s %d " BIT "\n"), FIELD_NAMES (type17_data_widths) },
+    { FIELD_COOK (smbios_type_17, size, TYPE17_SIZE, bios_cook_device_size), FIELD_NAMES (type17_sizes) },
+    { FIELD_ENUM (smbios_type_17, form_factor, TYPE17_FORM_FACTOR, type17_form_factors) },
+    { FIELD_NUM (smbios_type_17, device_set, TYPE17_DEVICE_SET, "%-35s%s %d\n"), FIELD_NAMES (type17_device_sets) },
+    { FIELD_STR (smbios_type_17, device_locator, TYPE17_DEVICE_LOCATOR) },
+    { FIELD_STR (smbios_type_17, bank_locator, TYPE17_BANK_LOCATOR) },
+    { FIELD_ENUM (smbios_type_17, mem_type, TYPE17_MEM_TYPE, type17_memory_types) },
+    { FIELD_BITS (smbios_type_17, type_detail, TYPE17_TYPE_DETAIL, type17_type_details) },
+    /* SMBIOS 2.3 and higher */
+    { FIELD_ABOVE (0x15) },
+    { FIELD_NUM (smbios_type_17, speed, TYPE17_SPEED, "%-35s%s %d " MHZ "\n"), FIELD_NAMES (smbios_hide_0) },
+    { FIELD_ABOVE (0x17) },
+    { FIELD_STR (smbios_type_17, manufacturer, TYPE17_MANUFACTURER) },
+    { FIELD_STR (smbios_type_17, serial_number, TYPE17_SERIAL_NUMBER) },
+    { FIELD_STR (smbios_type_17, asset_tag, TYPE17_ASSET_TAG) },
+    { FIELD_STR (smbios_type_17, part_number, TYPE17_PART_NUMBER) },
+};
+
+
+/*
+ * type 19 - memory array mapped address, type 20 - memory device mapped address
+ */
 
-/** \fn unsigned char * bios_cook_type_9 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 9 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 9 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 9 (System Slot) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+static const smbios_field type_19_fields[] = {
+    { FIELD_NUM (smbios_type_19, starting_adr, TYPE19_STARTING_ADR, "%-35s%s %.8X h\n") },
+    { FIELD_NUM (smbios_type_19, ending_adr, TYPE19_ENDING_ADR, "%-35s%s %.8X h\n") },
+    { FIELD_HANDLE (smbios_type_19, mem_array_handle, TYPE19_MEMORY_ARRAY_HANDLE) },
+    { FIELD_NUM (smbios_type_19, partition_width, TYPE19_PARTITION_WIDTH, "%-35s%s %d\n") },
+};
+
+static const smbios_name type20_row_positions[] = {
+    { 0,    0 },
+    { 0xFF, STR_TYPE20_PRP_UNKNOWN },
+};
+
+static const smbios_name type20_interleave_positions[] = {
+    { 0,    STR_TYPE20_IP_NOT_INTERLEAVED },
+    { 0xFF, STR_TYPE20_IP_UNKNOWN },
+};
+
+static const smbios_name type20_data_depths[] = {
+    { 0,    STR_TYPE20_IDD_NOT_INTERLEAVED },
+    { 0xFF, STR_TYPE20_IDD_UNKNOWN },
+};
+
+static const smbios_field type_20_fields[] = {
+    { FIELD_NUM (smbios_type_20, starting_adr, TYPE20_START_ADR, "%-35s%s %.8X h\n") },
+    { FIELD_NUM (smbios_type_20, ending_adr, TYPE20_END_ADR, "%-35s%s %.8X h\n") },
+    { FIELD_HANDLE (smbios_type_20, mem_dev_handle, TYPE20_MEM_DEV_HANDLE) },
+    { FIELD_HANDLE (smbios_type_20, mem_array_mapped_adr_handle, TYPE20_MEM_ARRAY_MAPPED_HANDLE) },
+    { FIELD_NUM (smbios_type_20, partition_row_position, TYPE20_PARTITION_ROW_POSITION, "%-35s%s %d\n"),
+      FIELD_NAMES (type20_row_positions) },
+    { FIELD_NUM (smbios_type_20, interleave_position, TYPE20_INTERLEAVE_POSITION, "%-35s%s %d\n"),
+      FIELD_NAMES (type20_interleave_positions) },
+    { FIELD_NUM (smbios_type_20, interleaved_data_depth, TYPE20_INTERLEAVED_DATA_DEPTH, "%-35s%s %d\n"),
+      FIELD_NAMES (type20_data_depths) },
+};
+
+
+/*
+ * type 32 - system boot information, type 127 - end of table
+ */
+
+static const __u16 type32_status[] = {
+    [0] = STR_TYPE32_STATUS_NO_ERROR,
+    [1] = STR_TYPE32_STATUS_NO_BOOT_MEDIA,
+    [2] = STR_TYPE32_STATUS_NO_OS,
+    [3] = STR_TYPE32_STATUS_FIRMWARE_HW,
+    [4] = STR_TYPE32_STATUS_OS_HW,
+    [5] = STR_TYPE32_STATUS_USER,
+    [6] = STR_TYPE32_STATUS_SECURITY,
+    [7] = STR_TYPE32_STATUS_REQUEST,
+    [8] = STR_TYPE32_STATUS_WATCHDOG,
+};
+static const smbios_field type_32_fields[] = {
+    { FIELD_ENUM (smbios_type_32, status, TYPE32_STATUS, type32_status) },
+};
+
+static const smbios_field type_127_fields[] = {
+    { show: SMBIOS_SHOW_TEXT, label: TYPE127_DESC, format: "%-35s%s " TYPE127_DESC_TEXT "\n\n" },
+};
+
+
+#define LAYOUT(n)   { n, sizeof (type_##n##_fields) / sizeof (smbios_field), TYPE##n##_NAME, type_##n##_fields }
+
+/** descriptors of all types the module interprets */
+static const smbios_layout smbios_layouts[] = {
+    LAYOUT (0), LAYOUT (1), LAYOUT (2), LAYOUT (3), LAYOUT (4), LAYOUT (5),
+    LAYOUT (6), LAYOUT (7), LAYOUT (8), LAYOUT (9), LAYOUT (10), LAYOUT (11),
+    LAYOUT (12), LAYOUT (13), LAYOUT (16), LAYOUT (17), LAYOUT (19), LAYOUT (20),
+    LAYOUT (32), LAYOUT (127),
+};
+
+
+/** \fn static const smbios_layout * bios_find_layout (unsigned int type)
+  * \brief looks up the descriptors of a structure type
+  * \param type structure type
+  * \return the descriptors, NULL if the type is not interpreted
   */
 
-unsigned char *
-bios_cook_type_9 (smbios_struct * smbiosstruct, unsigned int *plength)
+static const smbios_layout *
+bios_find_layout (unsigned int type)
 {
-	smbios_type_9 *type9;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-	/* is bigger than one pages (4k). since linux needs some space in this */
-	/* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
-	
-	/* contains one line of the above file */
-	unsigned char line[128];
-	
-
-    /* cast our data ptr to a structure ptr of SMBIOS type 9 */
-    type9 = (smbios_type_9 *)smbiosstruct;
+    unsigned int i;
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE9_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
- 	
-	/* prepare interpreted type 9 strings */
-	sprintf (line, "%-35s%s %s\n", TYPE9_DESIGNATION, SEP1, GetString(smbiosstruct, (unsigned int)(type9->designation)));
- 	strcat(file, line);
-
- 	switch(type9->type)
-	{
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_OTHER);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_UNKNOWN);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_ISA);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_MCA);
-	                break;
-	    case 5:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_EISA);
-	                break;
-        case 6:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PCI);
-	                break;
-        case 7:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PCMCIA);
-	                break;
-        case 8:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_VL);
-	                break;
-        case 9:     sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PROPRIETARY);
-	                break;
-        case 10:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PROCESSOR);
-	                break;
-        case 11:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_MEMORY);
-	                break;
-        case 12:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_RISER);
-	                break;
-        case 13:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_NUBUS);
-	                break;
-        case 14:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PCI66);
-	                break;
-        case 15:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_AGP);
-	                break;
-        case 16:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_AGP2);
-	                break;
-        case 17:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_AGP4);
-	                break;
-        case 18:    sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PCI_X);
-	                break;
-        case 160:   sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PC98_C20);
-	                break;
-        case 161:   sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PC98_C24);
-	                break;
-        case 162:   sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PC98_E);
-	                break;
-        case 163:   sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PC98_LOCAL_BUS);
-	                break;
-        case 164:   sprintf(line, "%-35s%s %s \n", TYPE9_TYPE, SEP1, TYPE9_TYPE_PC98_CARD);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE9_TYPE, SEP1, type9->type);
-	}
-	strcat(file, line);
 
- 	switch(type9->width)
-	{
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_OTHER);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_UNKNOWN);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_8);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_16);
-	                break;
-	    case 5:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_32);
-	                break;
-        case 6:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_64);
-	                break;
-        case 7:     sprintf(line, "%-35s%s %s \n", TYPE9_BUS_WIDTH, SEP1, TYPE9_BW_128);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE9_BUS_WIDTH, SEP1, type9->width);
-	}
-	strcat(file, line);
+    for (i = 0; i < sizeof (smbios_layouts) / sizeof (smbios_layout); i++)
+        if (smbios_layouts[i].type == type)
+            return &smbios_layouts[i];
 
- 	switch(type9->usage)
-	{
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE9_CURRENT_USAGE, SEP1, TYPE9_CU_OTHER);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE9_CURRENT_USAGE, SEP1, TYPE9_CU_UNKNOWN);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE9_CURRENT_USAGE, SEP1, TYPE9_CU_AVAILABLE);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE9_CURRENT_USAGE, SEP1, TYPE9_CU_IN_USE);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE9_CURRENT_USAGE, SEP1, type9->usage);
-	}
-	strcat(file, line);                	
-	
-	switch(type9->length)
-	{
-	    case 1:     sprintf(line, "%-35s%s %s \n", TYPE9_LENGTH, SEP1, TYPE9_LENGTH_OTHER);
-	                break;
-	    case 2:     sprintf(line, "%-35s%s %s \n", TYPE9_LENGTH, SEP1, TYPE9_LENGTH_UNKNOWN);
-	                break;
-	    case 3:     sprintf(line, "%-35s%s %s \n", TYPE9_LENGTH, SEP1, TYPE9_LENGTH_SHORT);
-	                break;
-	    case 4:     sprintf(line, "%-35s%s %s \n", TYPE9_LENGTH, SEP1, TYPE9_LENGTH_LONG);
-	                break;
-	    default:    sprintf(line, "%-35s%s %d \n", TYPE9_LENGTH, SEP1, type9->length);
-	}
-	strcat(file, line);
-	
-	if(type9->type == 0x04)
-	{
-	    if(type9->id1 > 0)
-	    {
-	        sprintf(line, "%-35s%s %d \n", TYPE9_ID_MCA_SLOT_NR, SEP1, type9->id1);
-	        strcat(file, line);
-	    }
-	}
-	
-	if(type9->type == 0x05)
-	{
-	    if(type9->id1 > 0)
-	    {
-	        sprintf(line, "%-35s%s %d \n", TYPE9_ID_EISA_SLOT_NR, SEP1, type9->id1);
-	        strcat(file, line);
-	    }
-	}
-	
-	if( ((type9->type >= 0x0F) && (type9->type <= 0x12)) ||
-	    (type9->type == 0x06) )
-	{
-	    sprintf(line, "%-35s%s %d \n", TYPE9_ID_PCI_SLOT_NR, SEP1, type9->id1);
-	    strcat(file, line);
-	}
-	
-	if(type9->type == 0x07)
-	{
-	    sprintf(line, "%-35s%s %d \n", TYPE9_ID_PCMCIA_ADAPTER_NR, SEP1, type9->id1);
-	    strcat(file, line);
-	    sprintf(line, "%-35s%s %d \n", TYPE9_ID_PCMCIA_SOCKET_NR, SEP1, type9->id2);
-	    strcat(file, line);
-	}
-	
-    sprintf(line, "%-35s%s\n", TYPE9_CHARACTERISTICS, SEP1);
-    strcat(file, line);
-    if( (type9->characteristics1) & 0x0001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_5V);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_33V);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_SHARED);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_PC_CARD_16);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_CARDBUS);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_ZOOM_VIDEO);
-        strcat(file, line);
-    }
-    if( (type9->characteristics1) & 0x0080 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_MODEM_RESUME);
-        strcat(file, line);
-    }
+    return NULL;
+}
 
 
-    /* SMBios 2.1 and higher */
-    if(smbiosstruct->length > 0x0C)
-    {
-        if( (type9->characteristics2) & 0x0001 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_PME);
-            strcat(file, line);
-        }
-        if( (type9->characteristics2) & 0x0002 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_HOT_PLUG);
-            strcat(file, line);
-        }
-        if( (type9->characteristics2) & 0x0004 )
-        {
-            sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE9_CHAR_SMBUS);
-            strcat(file, line);
-        }
-    }
+/** \fn static unsigned int bios_list_count (smbios_struct *smbiosstruct, const smbios_field *field)
+  * \brief returns the number of elements of a list
+  * \param smbiosstruct pointer to SMBIOS raw structure
+  * \param field the list
+  * \return number of elements, 255 if the list ends with the structure
+  */
 
+static unsigned int
+bios_list_count (smbios_struct *smbiosstruct, const smbios_field *field)
+{
+    if (!field->count)
+        return 255;
 
- 	
-    /* now line contains a string with fully interpreted type 9 data */
-	*plength = strlen(file);
+    return field->count < smbiosstruct->length ? ((unsigned char *) smbiosstruct)[field->count] : 0;
+}
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+/** \fn static unsigned int bios_calc (const smbios_field *field, unsigned int value)
+  * \brief calculates the number that is shown for a value
+  * \param field the field
+  * \param value the value
+  * \return the number
+  */
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+static unsigned int
+bios_calc (const smbios_field *field, unsigned int value)
+{
+    switch (field->calc)
+    {
+        case SMBIOS_CALC_PLUS_1:        return value + 1;
+        case SMBIOS_CALC_64K:           return (value + 1) * 64;
+        case SMBIOS_CALC_POW2:          return pow2 (value);
+        case SMBIOS_CALC_GRANULARITY:   return (value & 0x8000) ? (value & 0x7FFF) * 64 : value & 0x7FFF;
+        default:                        return value;
+    }
 }
 
 
-/** \fn unsigned char * bios_cook_type_10 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 10 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 10 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 10 (Onboard Device) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+/** \fn static unsigned int bios_decode_fields (smbios_value *values, unsigned int no_of_values, smbios_struct *smbiosstruct,
+  *                                            const smbios_field *fields, unsigned int no_of_fields,
+  *                                            unsigned int base, unsigned int index)
+  * \brief decodes the fields of a structure
+  * \param values the decoded values, NULL to count them only
+  * \param no_of_values number of values so far
+  * \param smbiosstruct pointer to SMBIOS raw structure
+  * \param fields the descriptors of the fields
+  * \param no_of_fields number of descriptors
+  * \param base offset the fields are relative to, the offset of the list element
+  * \param index number of the list element
+  * \return number of values including the new ones
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * every descriptor gives one value. a list is followed by the values of
+  * its elements, a SMBIOS_FIELD_STRINGS field by one value per string.
   */
 
-unsigned char *
-bios_cook_type_10 (smbios_struct * smbiosstruct, unsigned int *plength)
+static unsigned int
+bios_decode_fields (smbios_value *values, unsigned int no_of_values, smbios_struct *smbiosstruct,
+                    const smbios_field *fields, unsigned int no_of_fields, unsigned int base, unsigned int index)
 {
-	smbios_type_10 *type10;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-	/* is bigger than one pages (4k). since linux needs some space in this */
-	/* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
-	
-	/* contains one line of the above file */
-	unsigned char line[128];
-	
-	
-	int nr_of_devices = 0;
-	int i;
+    const smbios_field *field;
+    smbios_value *value;
+    smbios_value scratch;
+    const char *string;
+    unsigned int offset, count, i;
+    unsigned int list_end = 0;
 
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE10_NAME);
-    strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
- 	
-	nr_of_devices = ((int)(smbiosstruct->length) - 4) / 2;
-	
-	for(i=0; i < nr_of_devices; i++)
-	{
-        /* cast our data ptr to a structure ptr of SMBIOS type 10 */
-	    type10 = (smbios_type_10 *)( (unsigned char *)smbiosstruct + sizeof(smbios_header) + (i * sizeof(smbios_type_10)) );
-	
-	    /* prepare interpreted type 10 strings */
-	    sprintf (line, "%-35s%s %d\n", TYPE10_NR, SEP1, i);
- 	    strcat(file, line);
- 	
- 	    if(type10->type & 0x80)
- 	    {
- 	        sprintf (line, "%-35s%s %s\n", TYPE10_STATUS, SEP1, TYPE10_STATUS_ENABLED);
- 	        strcat(file, line);
- 	    }
- 	    else
- 	    {
- 	        sprintf (line, "%-35s%s %s\n", TYPE10_STATUS, SEP1, TYPE10_STATUS_DISABLED);
- 	        strcat(file, line);
- 	    }
- 	
- 	    switch(type10->type & 0x7F)
- 	    {
- 	        case 1:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_OTHER);
- 	                    break;
- 	        case 2:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_UNKNOWN);
- 	                    break;
- 	        case 3:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_VIDEO);
- 	                    break;
- 	        case 4:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_SCSI);
- 	                    break;
- 	        case 5:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_ETHERNET);
- 	                    break;
- 	        case 6:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_TOKEN_RING);
- 	                    break;
- 	        case 7:     sprintf(line, "%-35s%s %s\n", TYPE10_TYPE, SEP1, TYPE10_TYPE_SOUND);
- 	                    break;
- 	        default:    sprintf(line, "%-35s%s %d\n", TYPE10_TYPE, SEP1, type10->type & 0x7F);
- 	    }
- 	    strcat(file, line);
- 	
- 	    sprintf (line, "%-35s%s %s\n\n", TYPE10_DEV_NAME, SEP1, GetString(smbiosstruct, (unsigned int)(type10->description)));
- 	    strcat(file, line);
-	}
+    for (field = fields; field < fields + no_of_fields; field++)
+    {
+        offset = base + field->offset;
+        if (field->kind & SMBIOS_FIELD_AFTER_LIST)
+        {
+            offset = list_end + field->offset;
+            if (offset + field->width > smbiosstruct->length)
+                continue;
+        }
 
- 	
-    /* now line contains a string with fully interpreted type 10 data */
-	*plength = strlen(file);
+        if (field->show == SMBIOS_SHOW_ABOVE)
+        {
+            /* the rest of the fields is newer than the structure */
+            if (smbiosstruct->length <= field->offset)
+                return no_of_values;
+            continue;
+        }
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+        value = values ? &values[no_of_values] : &scratch;
+        no_of_values++;
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+        value->field = field;
+        value->offset = offset;
+        value->index = index;
+        value->flags = offset + field->width > smbiosstruct->length ? SMBIOS_VALUE_OUTSIDE : 0;
+        value->number = 0;
+        value->string = NULL;
+        value->data = (value->flags & SMBIOS_VALUE_OUTSIDE) ? NULL : (unsigned char *) smbiosstruct + offset;
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+        switch (field->kind & SMBIOS_FIELD_KIND)
+        {
+            /* a field behind the formatted area is not read, it would be the strings */
+            case SMBIOS_FIELD_INT:
+                if (value->data)
+                    value->number = bios_field_value (smbiosstruct, field, offset);
+                break;
+
+            case SMBIOS_FIELD_STRING:
+                if (value->data)
+                    value->string = GetString (smbiosstruct, *value->data);
+                break;
+
+            case SMBIOS_FIELD_STRINGS:
+                value->number = count = bios_list_count (smbiosstruct, field);
+
+                /* the strings the structure counts and the ones it has */
+                for (i = 1; i < 256; i++)
+                {
+                    if (!(string = GetString (smbiosstruct, i)) && i > count)
+                        break;
+
+                    value = values ? &values[no_of_values] : &scratch;
+                    no_of_values++;
+
+                    value->field = field;
+                    value->offset = offset;
+                    value->index = i;
+                    value->flags = SMBIOS_VALUE_ITEM;
+                    if (i > count)
+                        value->flags |= SMBIOS_VALUE_HIDDEN;
+                    if (!string)
+                        value->flags |= SMBIOS_VALUE_OUTSIDE;
+                    value->number = 0;
+                    value->string = string;
+                    value->data = NULL;
+                }
+                continue;
+        }
+
+        if (field->kind & SMBIOS_FIELD_LIST)
+        {
+            count = bios_list_count (smbiosstruct, field);
+
+            for (i = 0; count && offset + field->width <= smbiosstruct->length; i++, count--)
+            {
+                no_of_values = bios_decode_fields (values, no_of_values, smbiosstruct, (const smbios_field *) field->names,
+                                                   field->no_of_names, offset, i);
+                offset += field->stride;
+            }
+
+            /* the elements that were decoded */
+            value->number = i;
+            list_end = offset;
+        }
+    }
+
+    return no_of_values;
 }
 
 
-/** \fn unsigned char * bios_cook_type_11 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 11 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 11 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 11 (OEM Strings) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+/** \fn smbios_decoded * bios_decode (smbios_struct *smbiosstruct)
+  * \brief decodes a SMBIOS structure
+  * \param smbiosstruct pointer to SMBIOS raw structure
+  * \return pointer to the decoded structure, NULL if not enough memory
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the fields are decoded by the descriptors of the type in smbios_layouts[].
+  * structures of other types have no values. the strings and the bytes of
+  * the values point into the structure, so the decoded structure is valid
+  * as long as the raw one. the caller is responsible to free the memory.
   */
 
-
-unsigned char *
-bios_cook_type_11 (smbios_struct * smbiosstruct, unsigned int *plength)
+smbios_decoded *
+bios_decode (smbios_struct *smbiosstruct)
 {
-	smbios_type_11 *type11;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
+    const smbios_layout *layout;
+    smbios_decoded *decoded;
+    unsigned int count = 0;
 
-    /* contains one line of the above file */
-    unsigned char line[128];
-
-	unsigned char help[128];
-	
-	int nr_of_strings = 0;
-	int i, j;
 
+    /* do we have a valid SMBIOS? */
+    if (!smbiosstruct)
+        return NULL;
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE11_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
-
-	 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 11 */
-    type11 = (smbios_type_11 *)smbiosstruct;
- 	
-	nr_of_strings = (int)(type11->nr_of_strings);
-	
-	for(i=0; i < nr_of_strings; i++)
-	{
-	    sprintf(help, "%s %d", TYPE11_NR, i);
-	    for(j=35-strlen(help); j > 0; j--)
-	       strcat(help, " ");
-	
-	    /* prepare interpreted type 11 strings */
-	    sprintf (line, "%s %s\n", SEP1, GetString(smbiosstruct, (unsigned int)(i + 1)) );
- 	
-	    strcat(file, help);
- 	    strcat(file, line);
-	}
+    /* the values are counted first */
+    if ((layout = bios_find_layout (smbiosstruct->type)))
+        count = bios_decode_fields (NULL, 0, smbiosstruct, layout->fields, layout->no_of_fields, 0, 0);
 
- 	
-    /* now line contains a string with fully interpreted type 11 data */
-	*plength = strlen(file);
+    if (!(decoded = kmalloc (sizeof (smbios_decoded) + count * sizeof (smbios_value), GFP_KERNEL)))
+        return NULL;
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+    decoded->type = smbiosstruct->type;
+    decoded->length = smbiosstruct->length;
+    decoded->handle = smbiosstruct->handle;
+    decoded->layout = layout;
+    decoded->no_of_values = count;
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+    if (layout)
+        bios_decode_fields (decoded->values, 0, smbiosstruct, layout->fields, layout->no_of_fields, 0, 0);
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+    return decoded;
 }
 
 
-/** \fn unsigned char * bios_cook_type_12 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 12 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 12 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 12 (System Configuration Options) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+/** \fn static void bios_render_value (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
+  * \brief renders the interpreted data of one value
+  * \param render the output
+  * \param decoded the decoded structure
+  * \param value the value
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * every value gives at most a few lines, see SMBIOS_SHOW_...
   */
 
-unsigned char *
-bios_cook_type_12 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_render_value (smbios_render *render, const smbios_decoded *decoded, const smbios_value *value)
 {
-	smbios_type_12 *type12;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
-
-    /* contains one line of the above file */
-    unsigned char line[128];
-	
-	unsigned char help[128];
-	
-	int nr_of_strings = 0;
-	int i, j;
+    const smbios_field *field = value->field;
+    const smbios_name *name;
+    const __u16 *bits;
+    const char *label, *sep, *text;
+    char help[128];
+    char ref[64];
+    unsigned int i;
+    __u64 mask;
+    int bit;
+
+
+    /* like the binary format, the text leaves out what the structure does not have */
+    if (value->flags & SMBIOS_VALUE_OUTSIDE)
+        return;
+
+    /* an item of a list has no label of its own */
+    label = (field->flags & SMBIOS_FLAG_ITEM) ? "" : field->label;
+    sep = (field->flags & SMBIOS_FLAG_ITEM) ? SEP2 : SEP1;
+
+    switch (field->show)
+    {
+        case SMBIOS_SHOW_STRING:
+            bios_printf (render, field->format ? field->format : "%-35s%s %s\n", label, sep, value->string);
+            break;
+
+        case SMBIOS_SHOW_NUMBER:
+            if ((name = bios_find_name (field, value->number)))
+            {
+                if (!name->name)
+                    return;
+                bios_printf (render, (field->flags & SMBIOS_FLAG_SPACE) ? "%-35s%s %s \n" : "%-35s%s %s\n", label, sep,
+                             SMBIOS_STRING (name->name));
+            }
+            else if (field->format)
+                bios_printf (render, field->format, label, sep, bios_calc (field, value->number));
+            else
+                bios_printf (render, (field->flags & SMBIOS_FLAG_SPACE) ? "%-35s%s %d \n" : "%-35s%s %d\n", label, sep,
+                             (unsigned int) value->number);
+            break;
+
+        case SMBIOS_SHOW_ENUM:
+            if ((text = bios_enum_name (field, value->number)))
+                bios_printf (render, (field->flags & SMBIOS_FLAG_SPACE) ? "%-35s%s %s \n" : "%-35s%s %s\n", label, sep, text);
+            else
+                bios_printf (render, (field->flags & SMBIOS_FLAG_SPACE) ? "%-35s%s %d \n" : "%-35s%s %d\n", label, sep,
+                             (unsigned int) value->number);
+            break;
+
+        case SMBIOS_SHOW_BITS:
+            /* a bit field without label continues the one before */
+            if (label)
+            {
+                bios_printf (render, "%-35s%s\n", label, sep);
+            }
 
+            bits = (const __u16 *) field->names;
+            mask = bios_field_bits (field, value->number);
+            while ((bit = bios_next_bit (&mask)) >= 0)
+                bios_printf (render, "%-35s  %s %s \n", "", SEP2, SMBIOS_STRING (bits[bit]));
+            return;
+
+        case SMBIOS_SHOW_HEX:
+            bios_printf (render, "%-35s%s ", label, sep);
+            for (i = 0; i < field->width; i++)
+                bios_printf (render, "%.2X ", value->data[i]);
+            bios_printf (render, "\n");
+            break;
+
+        case SMBIOS_SHOW_HANDLE:
+            if ((name = bios_find_name (field, value->number)))
+            {
+                if (!name->name)
+                    return;
+                bios_printf (render, "%-35s%s %s\n", label, sep, SMBIOS_STRING (name->name));
+                break;
+            }
+            GetHandleRef (ref, value->number);
+            bios_printf (render, field->format ? field->format : "%-35s%s %s\n", label, sep, ref);
+            break;
+
+        case SMBIOS_SHOW_TEXT:
+            bios_printf (render, field->format, label, sep);
+            break;
+
+        case SMBIOS_SHOW_STRINGS:
+            if (!(value->flags & SMBIOS_VALUE_ITEM))
+            {
+                /* the strings are the items of a list */
+                if (!(field->flags & SMBIOS_FLAG_ITEM))
+                    return;
+                bios_printf (render, "%-35s%s \n", field->label, SEP1);
+                break;
+            }
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE12_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 12 */
-    type12 = (smbios_type_12 *)smbiosstruct;
- 	
-	nr_of_strings = (int)(type12->nr_of_strings);
-	
-	for(i=0; i < nr_of_strings; i++)
-	{
-	    sprintf(help, "%s %d", TYPE12_OPTION, i);
-	    for(j=35-strlen(help); j > 0; j--)
-	       strcat(help, " ");
-	
-	    /* prepare interpreted type 12 strings */
-	    sprintf (line, "%s %s\n", SEP1, GetString(smbiosstruct, (unsigned int)(i + 1)) );
- 	
- 	    strcat(file, help);
- 	    strcat(file, line);
-	}
+            if (value->flags & SMBIOS_VALUE_HIDDEN)
+                return;
 
- 	
-    /* now line contains a string with fully interpreted type 12 data */
-	*plength = strlen(file);
+            if (field->flags & SMBIOS_FLAG_ITEM)
+                bios_printf (render, "%-35s  %s %s\n", "", SEP2, value->string);
+            else
+            {
+                /* every string is numbered */
+                snprintf (help, sizeof (help), "%s %d", label, value->index - 1);
+                bios_printf (render, "%-35s%s %s\n", help, sep, value->string);
+            }
+            break;
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+        case SMBIOS_SHOW_LIST:
+            if (!label)
+                return;
+            bios_printf (render, "%-35s%s \n", label, sep);
+            break;
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+        case SMBIOS_SHOW_INDEX:
+            bios_printf (render, "%-35s%s %d\n", label, sep, value->index);
+            break;
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+        case SMBIOS_SHOW_COOK:
+            field->cook (render, decoded, value);
+            return;
+
+        default:
+            return;
+    }
 }
 
 
-/** \fn unsigned char * bios_cook_type_13 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 13 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 13 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static void bios_render (smbios_render *render, const smbios_decoded *decoded)
+  * \brief renders the interpreted data of a structure
+  * \param render the output
+  * \param decoded the decoded structure
   *
-  * this function gets a raw SMBIOS Type 13 (Bios Language Information) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * structures of types that are not interpreted just get the standard header.
   */
 
-unsigned char *
-bios_cook_type_13 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_render (smbios_render *render, const smbios_decoded *decoded)
 {
-	smbios_type_13 *type13;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
-
-    /* contains one line of the above file */
-    unsigned char line[128];
-	
-	int nr_of_strings = 0;
-	int i;
-
-
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE13_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 13 */
-    type13 = (smbios_type_13 *)smbiosstruct;
- 	
-	nr_of_strings = (int)(type13->nr_of_strings);
-	
-	sprintf(line, "%-35s%s \n", TYPE13_SUP_LANG, SEP1);
-	strcat(file, line);
-	for(i=0; i < nr_of_strings; i++)
-	{
-	    /* prepare interpreted type 13 strings */
-	    sprintf (line, "%-35s  %s %s\n", "", SEP2, GetString(smbiosstruct, (unsigned int)(i + 1)) );
- 	    strcat(file, line);
-	}
+    unsigned int i;
 
-	sprintf (line, "%-35s%s %s\n", TYPE13_CUR_LANG, SEP1, GetString(smbiosstruct, (unsigned int)(type13->current_language)) );
-    strcat(file, line);
- 	
-    /* now line contains a string with fully interpreted type 13 data */
-	*plength = strlen(file);
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
+	/* if it's none of the supported types, just display the standard
+	 * DMI header */
+	if (!decoded->layout)
 	{
-		*plength = 0;
-		return NULL;
+        bios_printf (render, "%20s : %d\n", TYPE, decoded->type);
+        bios_printf (render, "%20s : %d %s\n", LENGTH, decoded->length, BYTES);
+        bios_printf (render, "%20s : %d\n", HANDLE, decoded->handle);
+        bios_printf (render, "\n%s\n\n", NOT_SUPPORTED);
+        return;
 	}
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+    /* prepare header strings */
+    bios_printf (render, "%-35s%s %d %s\n", TYPE, SEP1, decoded->type, decoded->layout->name);
+    bios_printf (render, "%-35s%s %d %s\n", LENGTH, SEP1, decoded->length, BYTES);
+    bios_printf (render, "%-35s%s %d\n\n", HANDLE, SEP1, decoded->handle);
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+    for (i = 0; i < decoded->no_of_values; i++)
+        bios_render_value (render, decoded, &decoded->values[i]);
 }
 
 
-/** \fn unsigned char * bios_cook_type_16 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 16 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 16 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
-  *
-  * this function gets a raw SMBIOS Type 16 (Physical Memory Array) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+/** \fn static void bios_put_key (smbios_render *render, const smbios_decoded *decoded, const smbios_field *field,
+  *                               const char *key, int index)
+  * \brief renders the key of a key=value line
+  * \param render the output
+  * \param decoded the decoded structure
+  * \param field the field of the value
+  * \param key the label the key is made of
+  * \param index number of the item or of the list element, -1 if the value is neither
   *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the keys of a structure are unique. an item is numbered, a field that
+  * has the label of a field before, e.g. the parts of a packed field, gets
+  * the number of fields with that label.
   */
 
-unsigned char *
-bios_cook_type_16 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_put_key (smbios_render *render, const smbios_decoded *decoded, const smbios_field *field, const char *key, int index)
 {
-	smbios_type_16 *type16;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
-
-    /* contains one line of the above file */
-    unsigned char line[128];
+    const smbios_field *before;
+    int repeats = 1;
 
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE16_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 16 */
-    type16 = (smbios_type_16 *)smbiosstruct;
- 	
-    switch(type16->location)
+    if (index >= 0)
     {
- 	    case 1:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_OTHER);
- 	                break;
- 	    case 2:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_UNKNOWN);
- 	                break;
- 	    case 3:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_MOTHERBOARD);
- 	                break;
- 	    case 4:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_ISA);
- 	                break;
- 	    case 5:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_EISA);
- 	                break;
- 	    case 6:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PCI);
- 	                break;
- 	    case 7:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_MCA);
- 	                break;
- 	    case 8:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PCMCIA);
- 	                break;
- 	    case 9:     sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PRORIETARY);
- 	                break;
- 	    case 10:    sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_NUBUS);
- 	                break;
- 	    case 160:   sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PC98C20);
- 	                break;
- 	    case 161:   sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PC98C24);
- 	                break;
- 	    case 162:   sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PC98E);
- 	                break;
- 	    case 163:   sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PC98LOCAL);
- 	                break;
- 	    case 164:   sprintf(line, "%-35s%s %s\n", TYPE16_LOCATION, SEP1, TYPE16_L_PC98CARD);
- 	                break;
- 	    default:    sprintf(line, "%-35s%s %d\n", TYPE16_LOCATION, SEP1, type16->location);
- 	}
- 	strcat(file, line);
- 	
- 	switch(type16->use)
- 	{
- 	    case 1:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_OTHER);
- 	                break;
- 	    case 2:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_UNKNOWN);
- 	                break;
- 	    case 3:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_SYSTEM);
- 	                break;
- 	    case 4:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_VIDEO);
- 	                break;
- 	    case 5:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_FLASH);
- 	                break;
- 	    case 6:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_NON_VOLATILE);
- 	                break;
- 	    case 7:     sprintf(line, "%-35s%s %s\n", TYPE16_USE, SEP1, TYPE16_USE_CACHE);
- 	                break;
- 	    default:    sprintf(line, "%-35s%s %d\n", TYPE16_USE, SEP1, type16->use);
- 	}
- 	strcat(file, line);
- 	
- 	switch(type16->ecc)
- 	{
- 	    case 1:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_OTHER);
- 	                break;
- 	    case 2:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_UNKNOWN);
- 	                break;
- 	    case 3:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_NONE);
- 	                break;
- 	    case 4:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_PARITY);
- 	                break;
- 	    case 5:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_SINGLE_ECC);
- 	                break;
- 	    case 6:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_DOUBLE_ECC);
- 	                break;
- 	    case 7:     sprintf(line, "%-35s%s %s\n", TYPE16_ECC, SEP1, TYPE16_ECC_CRC);
- 	                break;
- 	    default:    sprintf(line, "%-35s%s %d\n", TYPE16_ECC, SEP1, type16->ecc);
- 	}
- 	strcat(file, line);
- 	
- 	if(type16->max_capacity & 0x80000000)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE16_MAX_CAPACITY, SEP1, TYPE16_MC_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	else
- 	{
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE16_MAX_CAPACITY, SEP1, type16->max_capacity, KB);
- 	    strcat(file, line);
- 	}
- 	
- 	if(type16->error_handle == 0xFFFE)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE16_ERROR_HANDLE, SEP1, TYPE16_EH_NOT_SUPPORTED);
- 	    strcat(file, line);
- 	}
-    if(type16->error_handle == 0xFFFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE16_ERROR_HANDLE, SEP1, TYPE16_EH_NO_ERROR);
- 	    strcat(file, line);
- 	}
- 	if(type16->error_handle < 0xFFFE)
- 	{
- 	    sprintf(line, "%-35s%s %s %d\n", TYPE16_ERROR_HANDLE, SEP1, TYPE16_EH_HANDLE, type16->error_handle);
- 	    strcat(file, line);
- 	}
- 	
- 	sprintf(line, "%-35s%s %d\n", TYPE16_NR_DEVICES, SEP1, type16->nr_of_devices);
- 	strcat(file, line);
- 	
-
-    /* now line contains a string with fully interpreted type 16 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+        bios_printf (render, "%s %d=", key, index);
+        return;
+    }
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+    for (before = decoded->layout->fields; before < field; before++)
+        if (before->kind && before->show != SMBIOS_SHOW_BITS && before->label && !strcmp (before->label, key))
+            repeats++;
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+    if (repeats > 1)
+        bios_printf (render, "%s %d=", key, repeats);
+    else
+        bios_printf (render, "%s=", key);
 }
 
 
-/** \fn unsigned char * bios_cook_type_17 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 17 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 17 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static void bios_render_keyvalue (smbios_render *render, const smbios_decoded *decoded)
+  * \brief renders the interpreted data of a structure as key=value lines
+  * \param render the output
+  * \param decoded the decoded structure
   *
-  * this function gets a raw SMBIOS Type 17 (Memory Device) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the header gives keys of its own. every value gives a line with the
+  * label of its field as key and the number, the string or the name of
+  * the value, without units. the items of a list, the strings and the bits
+  * of a bit field are numbered, see bios_put_key(). remarks, missing
+  * strings and what the structure does not have are left out.
   */
 
-unsigned char *
-bios_cook_type_17 (smbios_struct * smbiosstruct, unsigned int *plength)
+static void
+bios_render_keyvalue (smbios_render *render, const smbios_decoded *decoded)
 {
-	smbios_type_17 *type17;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
+    const smbios_value *value;
+    const smbios_field *field;
+    const smbios_field *list = NULL;
+    const smbios_name *name;
+    const __u16 *bits;
+    const char *key = NULL;
+    const char *text;
+    unsigned int i;
+    int index, count = 0;
+    __u64 mask;
+    int bit;
 
-    /* contains one line of the above file */
-    unsigned char line[128];
 
+    bios_printf (render, "%s=%d\n", KV_TYPE, decoded->type);
+    bios_printf (render, "%s=%d\n", KV_LENGTH, decoded->length);
+    bios_printf (render, "%s=%d\n", KV_HANDLE, decoded->handle);
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE17_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 17 */
-    type17 = (smbios_type_17 *)smbiosstruct;
-
-    sprintf(line, "%-35s%s %d\n", TYPE17_MEM_ARRAY_HANDLE, SEP1, type17->memory_array_handle);
- 	strcat(file, line);
- 	
- 	if(type17->error_handle == 0xFFFE)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_ERROR_HANDLE, SEP1, TYPE17_EH_NOT_SUPPORTED);
- 	    strcat(file, line);
- 	}
-    if(type17->error_handle == 0xFFFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_ERROR_HANDLE, SEP1, TYPE17_EH_NO_ERROR);
- 	    strcat(file, line);
- 	}
- 	if(type17->error_handle < 0xFFFE)
- 	{
- 	    sprintf(line, "%-35s%s %s %d\n", TYPE17_ERROR_HANDLE, SEP1, TYPE17_EH_HANDLE, type17->error_handle);
- 	    strcat(file, line);
- 	}
- 	
- 	if(type17->total_width == 0xFFFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_TOTAL_WIDTH, SEP1, TYPE17_TW_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	else
- 	{
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE17_TOTAL_WIDTH, SEP1, type17->total_width, BIT);
- 	    strcat(file, line);
- 	}
- 	
- 	if(type17->data_width == 0xFFFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_DATA_WIDTH, SEP1, TYPE17_DW_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	else
- 	{
- 	    sprintf(line, "%-35s%s %d %s\n", TYPE17_DATA_WIDTH, SEP1, type17->data_width, BIT);
- 	    strcat(file, line);
- 	}
- 	
- 	if(type17->size == 0)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_SIZE, SEP1, TYPE17_SIZE_NOT_INSTALLED);
- 	    strcat(file, line);
- 	}
- 	if(type17->size == 0xFFFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_SIZE, SEP1, TYPE17_SIZE_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	if((type17->size > 0) && (type17->size < 0xFFFF))
- 	{
- 	    if(type17->size & 0x8000)
- 	    {
- 	        sprintf(line, "%-35s%s %d %s\n", TYPE17_SIZE, SEP1, type17->size & 0x7FFF, KB);
- 	        strcat(file, line);
- 	    }
- 	    else
- 	    {
- 	        sprintf(line, "%-35s%s %d %s\n", TYPE17_SIZE, SEP1, type17->size, MB);
- 	        strcat(file, line);
- 	    }
- 	}
- 	 	
-    switch(type17->form_factor)
-    {
- 	    case 1:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_OTHER);
- 	                break;
- 	    case 2:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_UNKNOWN);
- 	                break;
- 	    case 3:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_SIMM);
- 	                break;
- 	    case 4:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_SIP);
- 	                break;
- 	    case 5:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_CHIP);
- 	                break;
- 	    case 6:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_DIP);
- 	                break;
- 	    case 7:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_ZIP);
- 	                break;
- 	    case 8:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_PROPRIETARY);
- 	                break;
- 	    case 9:     sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_DIMM);
- 	                break;
- 	    case 10:    sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_TSOP);
- 	                break;
- 	    case 11:    sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_ROW);
- 	                break;
- 	    case 12:    sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_RIMM);
- 	                break;
- 	    case 13:    sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_SODIMM);
- 	                break;
- 	    case 14:    sprintf(line, "%-35s%s %s\n", TYPE17_FORM_FACTOR, SEP1, TYPE17_FF_SRIMM);
- 	                break;
- 	    default:    sprintf(line, "%-35s%s %d\n", TYPE17_FORM_FACTOR, SEP1, type17->form_factor);
- 	}
- 	strcat(file, line);
- 	
- 	if(type17->device_set == 0)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_DEVICE_SET, SEP1, TYPE17_DEVICE_SET_NOT_IN_SET);
- 	    strcat(file, line);
- 	}
- 	if(type17->device_set == 0xFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_DEVICE_SET, SEP1, TYPE17_DEVICE_SET_UNKONWN);
- 	    strcat(file, line);
- 	}
- 	if((type17->device_set > 0) && (type17->device_set < 0xFF))
- 	{
- 	    sprintf(line, "%-35s%s %d\n", TYPE17_DEVICE_SET, SEP1, type17->device_set);
- 	    strcat(file, line);
- 	}
- 	
- 	sprintf(line, "%-35s%s %s\n", TYPE17_DEVICE_LOCATOR, SEP1, GetString(smbiosstruct, (unsigned int)(type17->device_locator)));
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %s\n", TYPE17_BANK_LOCATOR, SEP1, GetString(smbiosstruct, (unsigned int)(type17->bank_locator)));
- 	strcat(file, line);
- 	
- 	switch(type17->mem_type)
-    {
- 	    case 1:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_OTHER);
- 	                break;
- 	    case 2:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_UNKNOWN);
- 	                break;
- 	    case 3:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_DRAM);
- 	                break;
- 	    case 4:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_EDRAM);
- 	                break;
- 	    case 5:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_VRAM);
- 	                break;
- 	    case 6:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_SRAM);
- 	                break;
- 	    case 7:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_RAM);
- 	                break;
- 	    case 8:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_ROM);
- 	                break;
- 	    case 9:     sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_FLASH);
- 	                break;
- 	    case 10:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_EEPROM);
- 	                break;
- 	    case 11:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_FEPROM);
- 	                break;
- 	    case 12:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_EPROM);
- 	                break;
- 	    case 13:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_CDRAM);
- 	                break;
- 	    case 14:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_3DRAM);
- 	                break;
- 	    case 15:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_SDRAM);
- 	                break;
- 	    case 16:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_SGRAM);
- 	                break;
- 	    case 17:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_RDRAM);
- 	                break;
- 	    case 18:    sprintf(line, "%-35s%s %s\n", TYPE17_MEM_TYPE, SEP1, TYPE17_MT_DDR);
- 	                break;
- 	    default:    sprintf(line, "%-35s%s %d\n", TYPE17_MEM_TYPE, SEP1, type17->mem_type);
- 	}
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s\n", TYPE17_TYPE_DETAIL, SEP1);
-    strcat(file, line);
-    if( (type17->type_detail) & 0x0001 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_RESERVED);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0002 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_OTHER);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0004 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_UNKNOWN);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0008 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_FAST_PAGE);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0010 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_STATIC_COLUMN);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0020 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_PSEUDO_STATIC);
-        strcat(file, line);
-    }
- 	if( (type17->type_detail) & 0x0040 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_RAMBUS);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0080 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_SYNCHRONOUS);
-        strcat(file, line);
-    }
- 	if( (type17->type_detail) & 0x0100 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_CMOS);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0200 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_EDO);
-        strcat(file, line);
-    }
- 	if( (type17->type_detail) & 0x0400 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_WINDOW_DRAM);
-        strcat(file, line);
-    }
-    if( (type17->type_detail) & 0x0800 )
-    {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_CACHE_DRAM);
-        strcat(file, line);
-    }
- 	if( (type17->type_detail) & 0x1000 )
+    for (value = decoded->values; value < decoded->values + decoded->no_of_values; value++)
     {
-        sprintf(line, "%-35s  %s %s \n", "", SEP2, TYPE17_TD_NON_VOLATILE);
-        strcat(file, line);
-    }
+        field = value->field;
 
-    if(smbiosstruct->length > 0x15)
-    {
-        if(type17->speed > 0)
+        /* the values of the elements follow the list */
+        if (field->kind & SMBIOS_FIELD_LIST)
         {
-            sprintf(line, "%-35s%s %d %s\n", TYPE17_SPEED, SEP1, type17->speed, MHZ);
-            strcat(file, line);
+            list = field;
+            continue;
         }
-    }
 
-    if(smbiosstruct->length > 0x17)
-    {
-        sprintf(line, "%-35s%s %s\n", TYPE17_MANUFACTURER, SEP1, GetString(smbiosstruct, (unsigned int)(type17->manufacturer)));
- 	    strcat(file, line);
- 	
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_SERIAL_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type17->serial_number)));
- 	    strcat(file, line);
- 	
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_ASSET_TAG, SEP1, GetString(smbiosstruct, (unsigned int)(type17->asset_tag)));
- 	    strcat(file, line);
- 	
- 	    sprintf(line, "%-35s%s %s\n", TYPE17_PART_NUMBER, SEP1, GetString(smbiosstruct, (unsigned int)(type17->part_number)));
- 	    strcat(file, line);
+        index = -1;
+        if (list && field >= (const smbios_field *) list->names
+            && field < (const smbios_field *) list->names + list->no_of_names)
+            index = value->index;
+
+        /* a bit field without label continues the one before */
+        if (field->label)
+        {
+            key = field->label;
+            count = 0;
+        }
+        else if (index >= 0)
+            key = list->label;
+
+        if (!key || !field->kind || (value->flags & (SMBIOS_VALUE_OUTSIDE | SMBIOS_VALUE_HIDDEN)))
+            continue;
+
+        switch (field->kind & SMBIOS_FIELD_KIND)
+        {
+            case SMBIOS_FIELD_STRING:
+                if (!value->string)
+                    break;
+                bios_put_key (render, decoded, field, key, index);
+                bios_printf (render, "%s\n", value->string);
+                break;
+
+            case SMBIOS_FIELD_STRINGS:
+                /* the strings are the items */
+                if (!(value->flags & SMBIOS_VALUE_ITEM))
+                    break;
+                bios_put_key (render, decoded, field, key, value->index - 1);
+                bios_printf (render, "%s\n", value->string);
+                break;
+
+            case SMBIOS_FIELD_INT:
+                switch (field->show)
+                {
+                    case SMBIOS_SHOW_ENUM:
+                        bios_put_key (render, decoded, field, key, index);
+                        if ((text = bios_enum_name (field, value->number)))
+                            bios_printf (render, "%s\n", text);
+                        else
+                            bios_printf (render, "%u\n", (unsigned int) value->number);
+                        break;
+
+                    case SMBIOS_SHOW_BITS:
+                        bits = (const __u16 *) field->names;
+                        mask = bios_field_bits (field, value->number);
+                        while ((bit = bios_next_bit (&mask)) >= 0)
+                        {
+                            bios_put_key (render, decoded, field, key, count++);
+                            bios_printf (render, "%s\n", SMBIOS_STRING (bits[bit]));
+                        }
+                        break;
+
+                    case SMBIOS_SHOW_NUMBER:
+                    case SMBIOS_SHOW_HANDLE:
+                        if ((name = bios_find_name (field, value->number)))
+                        {
+                            if (name->name)
+                            {
+                                bios_put_key (render, decoded, field, key, index);
+                                bios_printf (render, "%s\n", SMBIOS_STRING (name->name));
+                            }
+                            break;
+                        }
+                        bios_put_key (render, decoded, field, key, index);
+                        bios_printf (render, "%u\n", bios_calc (field, value->number));
+                        break;
+
+                    default:
+                        /* the number as it is, e.g. of a field with a function of its own */
+                        bios_put_key (render, decoded, field, key, index);
+                        bios_printf (render, "%u\n", (unsigned int) value->number);
+                        break;
+                }
+                break;
+
+            default:
+                bios_put_key (render, decoded, field, key, index);
+                for (i = 0; i < field->width; i++)
+                    bios_printf (render, "%.2X", value->data[i]);
+                bios_printf (render, "\n");
+                break;
+        }
     }
- 	
+}
+
+
+/** \fn static unsigned char * bios_render_exact (const smbios_decoded *decoded,
+  *                                               void (*walk) (smbios_render *, const smbios_decoded *),
+  *                                               unsigned int *plength)
+  * \brief renders a structure into memory of the exact size
+  * \param decoded the structure, decoded by bios_decode()
+  * \param walk the renderer, bios_render() or bios_render_keyvalue()
+  * \param plength [OUT]-Param. length of the output
+  * \return pointer to the output, NULL if not enough memory
+  *
+  * the first pass only measures the output, the second one writes it into
+  * a buffer of that size, as bios_cook_binary() does. so the output has
+  * no upper limit and is not built on the stack.
+  */
+
+static unsigned char *
+bios_render_exact (const smbios_decoded *decoded, void (*walk) (smbios_render *, const smbios_decoded *),
+                   unsigned int *plength)
+{
+	smbios_render render;
+	unsigned char *out = NULL;
+	int pass;
 
-    /* now line contains a string with fully interpreted type 17 data */
-	*plength = strlen(file);
 
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
+	for (pass = 0; pass < 2; pass++)
 	{
-		*plength = 0;
-		return NULL;
+	    render.out = out;
+	    render.length = 0;
+	    render.size = pass ? *plength : 0;
+	    render.overflow = 0;
+	    walk (&render, decoded);
+
+	    if (!pass)
+	    {
+	        *plength = render.length;
+
+	        if (!(out = kmalloc (*plength + 1, GFP_KERNEL)))
+	        {
+	            *plength = 0;
+	            return NULL;
+	        }
+	    }
 	}
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+	/* only if a long piece got no memory in one of the passes */
+	if (render.overflow)
+	    PDEBUG ("output of structure %d cut at %d bytes\n", decoded->handle, render.length);
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+	*plength = render.length;
+
+	return out;
 }
 
 
-/** \fn unsigned char * bios_cook_type_19 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 19 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 19 raw structure
+/** \fn unsigned char * bios_cook (const smbios_decoded *decoded, unsigned int * plength)
+  * \brief renders the interpreted data of a structure
+  * \param decoded the structure, decoded by bios_decode()
   * \param plength amount of memory allocated by this function
   * \return pointer to string that holds the interpreted data
   *
-  * this function gets a raw SMBIOS Type 19 (Memory Array Mapped Address) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
+  * this function walks the values of a decoded structure and builds a
+  * string with the interpreted data. structures of types that are not
+  * interpreted just get the standard header. the memory is allocated in
+  * the exact size, see bios_render_exact(). the caller is responsible to
+  * free the memory.
   *
   * \author Joachim Braeuer
   * \date March 2001
   */
 
 unsigned char *
-bios_cook_type_19 (smbios_struct * smbiosstruct, unsigned int *plength)
+bios_cook (const smbios_decoded *decoded, unsigned int * plength)
 {
-	smbios_type_19 *type19;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
+	/* return a string with all the interpreted data for the given raw structure */
+	/* the caller is responsible to free the memory. */
+	return bios_render_exact (decoded, bios_render, plength);
+}
 
-    /* contains one line of the above file */
-    unsigned char line[128];
 
+/** \fn unsigned char * bios_cook_keyvalue (const smbios_decoded *decoded, unsigned int * plength)
+  * \brief renders the interpreted data of a structure as key=value lines
+  * \param decoded the structure, decoded by bios_decode()
+  * \param plength [OUT]-Param. length of the lines
+  * \return pointer to the lines, NULL if not enough memory
+  *
+  * the lines are rendered from the decoded values, see
+  * bios_render_keyvalue(). the keys and names are the very strings of
+  * strgdef.h. the caller is responsible to free the memory.
+  */
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE19_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 19 */
-    type19 = (smbios_type_19 *)smbiosstruct;
- 	
- 	sprintf(line, "%-35s%s %.8X h\n", TYPE19_STARTING_ADR, SEP1, type19->starting_adr);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %.8X h\n", TYPE19_ENDING_ADR, SEP1, type19->ending_adr);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %d\n", TYPE19_MEMORY_ARRAY_HANDLE, SEP1, type19->mem_array_handle);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %d\n", TYPE19_PARTITION_WIDTH, SEP1, type19->partition_width);
- 	strcat(file, line);
- 	
-
-    /* now line contains a string with fully interpreted type 19 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+unsigned char *
+bios_cook_keyvalue (const smbios_decoded *decoded, unsigned int * plength)
+{
+	return bios_render_exact (decoded, bios_render_keyvalue, plength);
+}
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+/** \fn static unsigned int bios_tlv_put (unsigned char *out, unsigned int size,
+  *                                       unsigned int id, unsigned int type, const void *value, unsigned int width)
+  * \brief appends a field to the fields of the binary format
+  * \param out the fields, NULL to measure only
+  * \param size bytes of the fields so far
+  * \param id field id
+  * \param type value type, SMBIOS_TLV_...
+  * \param value the value
+  * \param width bytes of the value
+  * \return bytes of the fields including the new one
+  */
+
+static unsigned int
+bios_tlv_put (unsigned char *out, unsigned int size, unsigned int id, unsigned int type, const void *value, unsigned int width)
+{
+    if (out)
+    {
+        out[size] = id;
+        out[size + 1] = type;
+        memcpy (out + size + 2, value, width);
+    }
+
+    return size + 2 + width;
 }
 
 
-/** \fn unsigned char * bios_cook_type_20 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 20 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 20 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static unsigned int bios_tlv_put_string (unsigned char *out, unsigned int size, unsigned int id,
+  *                                              const char *string, unsigned char *strings, unsigned int *strings_length)
+  * \brief appends a string field to the fields of the binary format
+  * \param out the fields, NULL to measure only
+  * \param size bytes of the fields so far
+  * \param id field id
+  * \param string the string, NULL if there is none
+  * \param strings the string block, only written if out is not NULL
+  * \param strings_length bytes of the string block so far, advanced by the length of the string
+  * \return bytes of the fields including the new one
   *
-  * this function gets a raw SMBIOS Type 20 (Memory Device Mapped Address) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * a missing string has the length 0.
   */
 
-unsigned char *
-bios_cook_type_20 (smbios_struct * smbiosstruct, unsigned int *plength)
+static unsigned int
+bios_tlv_put_string (unsigned char *out, unsigned int size, unsigned int id,
+                     const char *string, unsigned char *strings, unsigned int *strings_length)
 {
-	smbios_type_20 *type20;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
+    __u16 ref[2];
 
-    /* contains one line of the above file */
-    unsigned char line[128];
 
+    ref[0] = *strings_length;
+    ref[1] = string ? strlen (string) : 0;
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE20_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 20 */
-    type20 = (smbios_type_20 *)smbiosstruct;
- 	
- 	sprintf(line, "%-35s%s %.8X h\n", TYPE20_START_ADR, SEP1, type20->starting_adr);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %.8X h\n", TYPE20_END_ADR, SEP1, type20->ending_adr);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %d\n", TYPE20_MEM_DEV_HANDLE, SEP1, type20->mem_dev_handle);
- 	strcat(file, line);
- 	
- 	sprintf(line, "%-35s%s %d\n", TYPE20_MEM_ARRAY_MAPPED_HANDLE, SEP1, type20->mem_array_mapped_adr_handle);
- 	strcat(file, line);
- 	
- 	if(type20->partition_row_position == 0xFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE20_PARTITION_ROW_POSITION, SEP1, TYPE20_PRP_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	if( (type20->partition_row_position > 0) && (type20->partition_row_position < 0xFF))
- 	{
- 	    sprintf(line, "%-35s%s %d\n", TYPE20_PARTITION_ROW_POSITION, SEP1, type20->partition_row_position);
- 	    strcat(file, line);
- 	}
- 	
- 	if(type20->interleave_position == 0)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE20_INTERLEAVE_POSITION, SEP1, TYPE20_IP_NOT_INTERLEAVED);
- 	    strcat(file, line);
- 	}
- 	if(type20->interleave_position == 0xFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE20_INTERLEAVE_POSITION, SEP1, TYPE20_IP_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	if( (type20->interleave_position > 0) && (type20->interleave_position < 0xFF))
- 	{
- 	    sprintf(line, "%-35s%s %d\n", TYPE20_INTERLEAVE_POSITION, SEP1, type20->interleave_position);
- 	    strcat(file, line);
- 	}
- 	
- 	if(type20->interleaved_data_depth == 0)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE20_INTERLEAVED_DATA_DEPTH, SEP1, TYPE20_IDD_NOT_INTERLEAVED);
- 	    strcat(file, line);
- 	}
- 	if(type20->interleaved_data_depth == 0xFF)
- 	{
- 	    sprintf(line, "%-35s%s %s\n", TYPE20_INTERLEAVED_DATA_DEPTH, SEP1, TYPE20_IDD_UNKNOWN);
- 	    strcat(file, line);
- 	}
- 	if( (type20->interleaved_data_depth > 0) && (type20->interleaved_data_depth < 0xFF))
- 	{
- 	    sprintf(line, "%-35s%s %d\n", TYPE20_INTERLEAVED_DATA_DEPTH, SEP1, type20->interleaved_data_depth);
- 	    strcat(file, line);
- 	}
- 	
-
-    /* now line contains a string with fully interpreted type 20 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+    if (out && ref[1])
+        memcpy (strings + ref[0], string, ref[1]);
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+    *strings_length += ref[1];
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+    return bios_tlv_put (out, size, id, SMBIOS_TLV_STRING, ref, sizeof (ref));
 }
 
 
-/** \fn unsigned char * bios_cook_type_32 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 32 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 32 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn static unsigned int bios_tlv_put_value (unsigned char *out, unsigned int size, const smbios_value *value,
+  *                                             unsigned char *strings, unsigned int *strings_length)
+  * \brief appends one decoded value to the fields of the binary format
+  * \param out the fields, NULL to measure only
+  * \param size bytes of the fields so far
+  * \param value the value, its offset is the field id
+  * \param strings the string block, only written if out is not NULL
+  * \param strings_length bytes of the string block so far
+  * \return bytes of the fields including the new one
   *
-  * this function gets a raw SMBIOS Type 32 (System Boot Information) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * integers are given as they are in the structure, so enumerations are
+  * numeric codes. a value that is only some bits of the field is given
+  * with its mask. the strings of a SMBIOS_FIELD_STRINGS field have the
+  * field id 0.
   */
 
-unsigned char *
-bios_cook_type_32 (smbios_struct * smbiosstruct, unsigned int *plength)
+static unsigned int
+bios_tlv_put_value (unsigned char *out, unsigned int size, const smbios_value *value,
+                    unsigned char *strings, unsigned int *strings_length)
 {
-	smbios_type_32 *type32;
-    unsigned char * scratch;
-	
-	/* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
+    unsigned int width = value->field->width;
+    __u32 part[2];
 
-    /* contains one line of the above file */
-    unsigned char line[128];
 
+    switch (value->field->kind & SMBIOS_FIELD_KIND)
+    {
+        case SMBIOS_FIELD_INT:
+            if (value->field->mask)
+            {
+                part[0] = value->field->mask;
+                part[1] = value->number;
+                return bios_tlv_put (out, size, value->offset, SMBIOS_TLV_PART, part, sizeof (part));
+            }
 
-    /* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE32_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    /* cast our data ptr to a structure ptr of SMBIOS type 32 */
-    type32 = (smbios_type_32 *)smbiosstruct;
- 	
- 	switch(type32->status)
- 	{
- 	    case 0:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_NO_ERROR);
- 	                break;
- 	    case 1:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_NO_BOOT_MEDIA);
- 	                break;
- 	    case 2:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_NO_OS);
- 	                break;
- 	    case 3:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_FIRMWARE_HW);
- 	                break;
- 	    case 4:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_OS_HW);
- 	                break;
- 	    case 5:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_USER);
- 	                break;
- 	    case 6:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_SECURITY);
- 	                break;
- 	    case 7:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_REQUEST);
- 	                break;
- 	    case 8:     sprintf(line, "%-35s%s %s\n", TYPE32_STATUS, SEP1, TYPE32_STATUS_WATCHDOG);
- 	                break;
- 	    default:    sprintf(line, "%-35s%s %d\n", TYPE32_STATUS, SEP1, type32->status); 	
- 	}
- 	strcat(file, line);
- 	
- 	
- 	/* now line contains a string with fully interpreted type 32 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
-	{
-		*plength = 0;
-		return NULL;
-	}
+            switch (width)
+            {
+                case 1:     return bios_tlv_put (out, size, value->offset, SMBIOS_TLV_U8, value->data, 1);
+                case 2:     return bios_tlv_put (out, size, value->offset, SMBIOS_TLV_U16, value->data, 2);
+                case 4:     return bios_tlv_put (out, size, value->offset, SMBIOS_TLV_U32, value->data, 4);
+                default:    return bios_tlv_put (out, size, value->offset, SMBIOS_TLV_U64, value->data, 8);
+            }
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+        case SMBIOS_FIELD_STRING:
+            return bios_tlv_put_string (out, size, value->offset, value->string, strings, strings_length);
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
-	return scratch;
+        case SMBIOS_FIELD_STRINGS:
+            return bios_tlv_put_string (out, size, 0, value->string, strings, strings_length);
+
+        default:
+            /* the length byte goes in front of the bytes */
+            if (out)
+            {
+                out[size] = value->offset;
+                out[size + 1] = SMBIOS_TLV_BYTES;
+                out[size + 2] = width;
+                memcpy (out + size + 3, value->data, width);
+            }
+            return size + 3 + width;
+    }
 }
 
 
-/** \fn unsigned char * bios_cook_type_127 (smbios_struct *smbiosstruct, unsigned int * plength)
-  * \brief writes interpreted SMBIOS Type 127 data to a /proc file
-  * \param smbiosstruct pointer to SMBIOS Type 127 raw structure
-  * \param plength amount of memory allocated by this function
-  * \return pointer to string that holds the interpreted data
+/** \fn unsigned char * bios_cook_binary (const smbios_decoded *decoded, unsigned int * plength)
+  * \brief renders a structure in the binary format
+  * \param decoded the structure, decoded by bios_decode()
+  * \param plength [OUT]-Param. length of the structure in the binary format
+  * \return pointer to the structure in the binary format, NULL if not enough memory
   *
-  * this function gets a raw SMBIOS Type 127 (System Boot Information) structure. it
-  * interpretes the raw data and builds a string with the interpreted
-  * data. this is the return value of this structure. the caller is
-  * responsible to free the allocated memory.
-  *
-  * \author Joachim Braeuer
-  * \date March 2001
+  * the binary format is a smbios_tlv_header, followed by the fields and the
+  * string block. every value in the formatted area of the structure is a
+  * field, values that only show a field in another way and the values of
+  * lists are left out. the structure is measured first and then written
+  * into a buffer of the exact size. the caller is responsible to free the
+  * memory.
   */
 
 unsigned char *
-bios_cook_type_127 (smbios_struct * smbiosstruct, unsigned int *plength)
+bios_cook_binary (const smbios_decoded *decoded, unsigned int * plength)
 {
-    unsigned char * scratch;
-
-    /* contains the full block of interpreted data */
-    /* on some systems the system crashed if the stack (local variables) */
-    /* is bigger than one pages (4k). since linux needs some space in this */
-    /* page the variables should never exceed 3kB. */
-    unsigned char file[2800];
-
-    /* contains one line of the above file */
-    unsigned char line[128];
-
-
-	/* prepare header strings */
-    sprintf (line, "%-35s%s %d %s\n", TYPE, SEP1, smbiosstruct->type, TYPE127_NAME);
-	strcpy(file, line);
-	sprintf (line, "%-35s%s %d %s\n", LENGTH, SEP1, smbiosstruct->length, BYTES);
-	strcat(file, line);
-	sprintf (line, "%-35s%s %d\n\n", HANDLE, SEP1, smbiosstruct->handle);
-	strcat(file, line);
- 	
-    sprintf (line, "%-35s%s %s\n\n", TYPE127_DESC, SEP1, TYPE127_DESC_TEXT);
- 	strcat(file, line);
- 	
- 	
- 	/* now line contains a string with fully interpreted type 32 data */
-	*plength = strlen(file);
-
-	/* allocate memory */
-	scratch = kmalloc (*plength+1, GFP_KERNEL);
-	if (scratch == NULL)
+	const smbios_value *value;
+	const smbios_field *field;
+	smbios_tlv_header *header;
+	unsigned char *scratch = NULL;
+	unsigned char *fields = NULL;
+	unsigned char *strings = NULL;
+	unsigned int size = 0;
+	unsigned int strings_length = 0;
+	int pass;
+
+
+	/* the first pass measures the fields and the strings, the second one writes them */
+	for (pass = 0; pass < 2; pass++)
 	{
-		*plength = 0;
-		return NULL;
+	    size = 0;
+	    strings_length = 0;
+
+	    for (value = decoded->values; value < decoded->values + decoded->no_of_values; value++)
+	    {
+	        field = value->field;
+
+	        /* the values packed into one field are given one by one */
+	        if (!field->kind || ((field->flags & SMBIOS_FLAG_SAME) && !field->mask) || (field->kind & SMBIOS_FIELD_LIST))
+	            continue;
+	        if (value->flags & SMBIOS_VALUE_OUTSIDE)
+	            continue;
+	        if ((field->kind & SMBIOS_FIELD_KIND) == SMBIOS_FIELD_STRINGS && !(value->flags & SMBIOS_VALUE_ITEM))
+	            continue;
+
+	        size = bios_tlv_put_value (fields, size, value, strings, &strings_length);
+	    }
+
+	    if (!pass)
+	    {
+	        *plength = sizeof (smbios_tlv_header) + size + strings_length;
+
+	        if (!(scratch = kmalloc (*plength, GFP_KERNEL)))
+	        {
+	            *plength = 0;
+	            return NULL;
+	        }
+
+	        fields = scratch + sizeof (smbios_tlv_header);
+	        strings = fields + size;
+	    }
 	}
 
-	/* copy the interpreted data */
-	memcpy (scratch, file, *plength);
+	header = (smbios_tlv_header *) scratch;
+	header->type = decoded->type;
+	header->length = decoded->length;
+	header->handle = decoded->handle;
+	header->fields_length = size;
+	header->strings_length = strings_length;
 
-	/* return a string with all the interpreted data for the given raw structure. */
-	/* the caller is responsible to free the memory. */	
+	/* the caller is responsible to free the memory. */
 	return scratch;
 }
 
@@ -3975,7 +2375,9 @@ bios_cook_type_127 (smbios_struct * smbiosstruct, unsigned int *plength)
   * \return pointer to string that holds the desired string
   *
   * a string number of zero indicates that there is no string to fetch.
-  * this function jumps to the end of the structure and walks through the
+  * the strings of every structure in the index are recorded at load time,
+  * so the string is looked up directly. for any other structure this
+  * function jumps to the end of the structure and walks through the
   * strings behind it. the strings are seperated by 0x00. a double 0x00
   * indicates the end of the strings section.
   *
@@ -3989,12 +2391,21 @@ GetString(smbios_struct *struct_ptr, unsigned int stringnr)
 {
 	unsigned int str_stringnr = 0;
 	unsigned char *ptr = NULL;
+	smbios_index_entry *entry;
 
 
     /* if we should get string nr 0, we have nothing to do */
 	if (stringnr == str_stringnr)
         return NULL;
 
+    if ((entry = smbios_find_struct (struct_ptr)))
+    {
+        if (stringnr > entry->string_count)
+            return NULL;
+
+        return (char *) smbios_index_base + smbios_string_refs[entry->strings + stringnr - 1].offset;
+    }
+
 	str_stringnr = 1;
 
     /* jump to string list */
@@ -4016,6 +2427,43 @@ GetString(smbios_struct *struct_ptr, unsigned int stringnr)
 }
 
 
+/** \fn unsigned int GetHandleRef (char *ref, unsigned int handle)
+  * \brief formats a handle that refers to another structure
+  * \param ref [OUT]-Param. contains the handle and the readable name of the structure
+  * \param handle handle of the referenced structure
+  * \return length of the string in ref
+  *
+  * the handle is printed as a number. If a structure with this handle
+  * exists, its readable type name is appended, e.g. "16 (cache)".
+  * ref must hold at least 64 characters.
+  */
+
+unsigned int
+GetHandleRef(char *ref, unsigned int handle)
+{
+    smbios_index_entry *entry;
+    smbios_struct *struct_ptr;
+    unsigned int length;
+
+
+    length = sprintf(ref, "%d", handle);
+
+    if((entry = smbios_find_handle(handle)) == NULL)
+        return length;
+
+    struct_ptr = smbios_index_struct(entry);
+
+    length += sprintf(ref + length, " (");
+    if(smbios_type_has_subtype(entry->type))
+        length += smbios_get_readable_name_ext(ref + length, struct_ptr);
+    else
+        length += smbios_get_readable_name(ref + length, struct_ptr);
+    length += sprintf(ref + length, ")");
+
+    return length;
+}
+
+
 /** \fn unsigned int pow2 (unsigned int n)
   * \brief returns the n-th power of 2 (2*2*2...)
   * \param n Indicates how often we should multiply 2 with itself
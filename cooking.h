@@ -46,29 +46,16 @@
  * function prototypes
  */
 
+struct smbios_decoded;
+struct smbios_value;
+struct smbios_render;
+
 /* description: see implementation file */
-unsigned char * bios_cook (smbios_struct * smbiostype, unsigned int *length);
-
-unsigned char * bios_cook_type_0 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_1 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_2 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_3 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_4 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_5 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_6 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_7 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_8 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_9 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_10 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_11 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_12 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_13 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_16 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_17 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_19 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_20 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_32 (smbios_struct * smbiostype, unsigned int *length);
-unsigned char * bios_cook_type_127 (smbios_struct * smbiostype, unsigned int *length);
+struct smbios_decoded * bios_decode (smbios_struct * smbiostype);
+unsigned char * bios_cook (const struct smbios_decoded *decoded, unsigned int *length);
+unsigned char * bios_cook_keyvalue (const struct smbios_decoded *decoded, unsigned int *length);
+unsigned char * bios_cook_binary (const struct smbios_decoded *decoded, unsigned int *length);
+
 
 
 
@@ -343,11 +330,186 @@ typedef struct smbios_type_32
 
 
 
+/**
+ * field descriptors, see bios_decode()
+ */
+
+/** kinds of fields, the lower four bits */
+#define SMBIOS_FIELD_INT        1   /* little endian integer of 1, 2, 4 or 8 bytes */
+#define SMBIOS_FIELD_STRING     2   /* string number */
+#define SMBIOS_FIELD_BYTES      3   /* bytes taken as they are, e.g. a UUID */
+#define SMBIOS_FIELD_STRINGS    4   /* all strings of the structure, e.g. the OEM strings */
+#define SMBIOS_FIELD_KIND       0x0F
+/** the field is a list of elements that are stride bytes apart, the fields
+ * of an element are the descriptors in names. The number of elements is
+ * the byte at count, resp. up to the end of the formatted area if count
+ * is 0 */
+#define SMBIOS_FIELD_LIST       0x40
+/** the offset of the field is relative to the end of the last list */
+#define SMBIOS_FIELD_AFTER_LIST 0x80
+
+/** how a field is shown in the interpreted data. A list or bit field
+ * without a label has no line of its own before its items. */
+#define SMBIOS_SHOW_NONE        0   /* not at all */
+#define SMBIOS_SHOW_STRING      1   /* the string */
+#define SMBIOS_SHOW_NUMBER      2   /* the name of the value in names, else the value by format */
+#define SMBIOS_SHOW_BITS        3   /* a list of the names of the bits that are set */
+#define SMBIOS_SHOW_HEX         4   /* the bytes in hex */
+#define SMBIOS_SHOW_HANDLE      5   /* the name of the value in names, else the referenced structure */
+#define SMBIOS_SHOW_TEXT        6   /* format, no value */
+#define SMBIOS_SHOW_STRINGS     7   /* the first n strings, n is the byte at count */
+#define SMBIOS_SHOW_LIST        8   /* the elements of a list */
+#define SMBIOS_SHOW_INDEX       9   /* the number of the element of a list */
+#define SMBIOS_SHOW_COOK        10  /* by the function cook */
+#define SMBIOS_SHOW_ENUM        11  /* the name of the value in the table names, else the value */
+/** the following fields are shown only if the structure is longer than
+ * offset. They were added by a later version of the specification. */
+#define SMBIOS_SHOW_ABOVE       12
+
+/** flags of a field */
+#define SMBIOS_FLAG_SPACE       0x01    /* the line of a name ends with a blank */
+#define SMBIOS_FLAG_ITEM        0x02    /* an item of a list, not a line of its own */
+#define SMBIOS_FLAG_SAME        0x04    /* the field of the descriptor before, shown in another way */
+
+/** how a number is calculated from the value */
+#define SMBIOS_CALC_NONE        0
+#define SMBIOS_CALC_PLUS_1      1   /* value + 1 */
+#define SMBIOS_CALC_64K         2   /* (value + 1) 64k blocks, in kB */
+#define SMBIOS_CALC_POW2        3   /* 2 ^ value */
+#define SMBIOS_CALC_GRANULARITY 4   /* bit 15 set: value in 64 kB, in kB */
+
+/** name of a value of a field */
+typedef struct smbios_name
+{
+    __u16           value;
+    /** offset of the name in the string pool, 0 if the field is not shown for this value */
+    __u16           name;
+} smbios_name;
+
+/** one field of the formatted area of a structure */
+typedef struct smbios_field
+{
+    __u8    offset;
+    __u8    kind;
+    /** bytes of the field, resp. of one element of a list */
+    __u8    width;
+    __u8    stride;
+    __u8    count;
+    __u8    show;
+    __u8    flags;
+    __u8    calc;
+    /** bits of the value that are shown, 0 for all, and how far they are shifted */
+    __u32   mask;
+    __u8    shift;
+    __u16   no_of_names;
+    const char  *label;
+    /** format of the line, it is given the label, the separator and the value */
+    const char  *format;
+    /** smbios_name values, the names indexed by the value of an enumeration,
+     * the names of the bits, resp. the fields of a list element. A name is
+     * the offset of a string of the pool, see strpool.awk */
+    const void  *names;
+    void (*cook) (struct smbios_render *render, const struct smbios_decoded *decoded, const struct smbios_value *value);
+} smbios_field;
+
+/** the fields of one structure type */
+typedef struct smbios_layout
+{
+    __u8                type;
+    __u8                no_of_fields;
+    const char          *name;
+    const smbios_field  *fields;
+} smbios_layout;
+
+/** flags of a decoded value */
+#define SMBIOS_VALUE_OUTSIDE    0x01    /* not in the formatted area, resp. a missing string, neither read nor shown */
+#define SMBIOS_VALUE_HIDDEN     0x02    /* a string the structure does not count, not shown */
+#define SMBIOS_VALUE_ITEM       0x04    /* one of the strings of a SMBIOS_FIELD_STRINGS field */
+
+/** one decoded field of a structure */
+typedef struct smbios_value
+{
+    const smbios_field  *field;
+    /** offset of the field in the structure */
+    __u8    offset;
+    /** number of the list element, resp. of the string */
+    __u8    index;
+    __u8    flags;
+    /** the bits of an integer the field shows, the number of elements of a list */
+    __u64   number;
+    /** the string of a string field, NULL if there is none */
+    const char  *string;
+    /** the field in the raw structure */
+    const unsigned char *data;
+} smbios_value;
+
+/** a structure decoded by bios_decode(). The values are in the order of
+ * the descriptors, the values of the elements of a list follow the value
+ * of the list. The renderers bios_cook(), bios_cook_keyvalue() and
+ * bios_cook_binary() only walk the values.
+ */
+typedef struct smbios_decoded
+{
+    __u8                type;
+    __u8                length;
+    __u16               handle;
+    /** NULL if the type is not interpreted */
+    const smbios_layout *layout;
+    unsigned int        no_of_values;
+    smbios_value        values[0];
+} smbios_decoded;
+
+/** longest piece of the interpreted data that is formatted at once */
+#define SMBIOS_RENDER_PIECE     128
+
+/** output of the text renderers, bios_render() and bios_render_keyvalue().
+ * The output is written at length and never beyond size, without out it
+ * is only measured, see bios_append(). */
+typedef struct smbios_render
+{
+    unsigned char   *out;
+    unsigned int    length;
+    unsigned int    size;
+    /** set if the output was cut */
+    int             overflow;
+} smbios_render;
+
+/** value types of the binary format */
+#define SMBIOS_TLV_U8           1
+#define SMBIOS_TLV_U16          2
+#define SMBIOS_TLV_U32          3
+#define SMBIOS_TLV_U64          4
+#define SMBIOS_TLV_STRING       5   /* __u16 offset, __u16 length into the string block */
+#define SMBIOS_TLV_BYTES        6   /* __u8 length, followed by the bytes */
+#define SMBIOS_TLV_PART         7   /* __u32 mask, __u32 the masked bits shifted down to bit 0 */
+
+/** header of a structure in the binary format. It is followed by the
+ * fields and the string block. Every field is a __u8 field id, that is
+ * the offset of the field in the structure (0 for the strings of a
+ * SMBIOS_FIELD_STRINGS field), a __u8 value type and the value. All
+ * values are in the byte order of the machine. A field that packs
+ * several values, e.g. the status and the socket bit of a processor,
+ * gives one SMBIOS_TLV_PART per value, all with the id of the field.
+ */
+typedef struct smbios_tlv_header
+{
+    __u8    type                           __attribute__ ((packed));
+    __u8    length                         __attribute__ ((packed));
+    __u16   handle                         __attribute__ ((packed));
+	/** bytes of the fields behind the header */
+    __u16   fields_length                  __attribute__ ((packed));
+	/** bytes of the string block behind the fields */
+    __u16   strings_length                 __attribute__ ((packed));
+} smbios_tlv_header;
+
+
+
 /**
  * helper functions
  */
 
 char * GetString(smbios_struct *structure, unsigned int stringnr);
+unsigned int GetHandleRef(char *ref, unsigned int handle);
 unsigned int pow2(unsigned int);
 
 #endif /* __COOKING_H__ */
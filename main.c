@@ -56,12 +56,27 @@ char kernel_version[] = UTS_RELEASE;
 #include <linux/types.h>	/* size_t */
 #include <linux/proc_fs.h>
 #include <asm/io.h>		    /* ioremap() */
+#ifdef _DEBUG_
+#include <asm/timex.h>		/* get_cycles() */
+#endif
 
 #include "strgdef.h"        /* holds all the interpreted/cooked string definitions */
 #include "bios.h"		    /* local definitions */
 
 EXPORT_NO_SYMBOLS;
 
+/** copy the tables into kernel memory at load time (1) or read them through
+ *  the ioremap()ed BIOS area on every access (0) */
+static int snapshot = 1;
+MODULE_PARM (snapshot, "i");
+MODULE_PARM_DESC (snapshot, "copy the SMBIOS tables into kernel memory (default 1)");
+
+/** physical address of the SM-BIOS entry point, 0 to ask the firmware or
+ *  to scan the F-segment */
+static unsigned long entry_point = 0;
+MODULE_PARM (entry_point, "l");
+MODULE_PARM_DESC (entry_point, "physical address of the SMBIOS entry point (default: search)");
+
 /*
  *   Module stuff
  */
@@ -79,27 +94,62 @@ int
 init_module (void)
 {
     int err = 0;
+    smbios_anchors anchors;     /* entry points found in the F-segment */
+#ifdef _DEBUG_
+    cycles_t start;         /* to measure the time needed to create the files */
+#endif
 
 
     PDEBUG ("starting module initialization\n");
 
     /*
-     *  map the SMBIOS memory segment
-     *
-     *  ioremap (kernel) maps a physical address to a virtual address.
-     *  bios start address is e.g. the Bios F-Segment
+     *  take the entry point from the firmware if we are told where it is,
+     *  either by the entry_point module parameter or by the EFI system
+     *  table. On EFI machines the F-segment often holds no entry point at
+     *  all. Only SM-BIOS entry points are taken from there, the DMI-BIOS
+     *  structures are addressed relative to the F-segment.
      */
+    if (!entry_point)
+        entry_point = smbios_firmware_entry_point ();
 
-    if (!(smbios_base = ioremap (BIOS_START_ADDRESS, BIOS_MAP_LENGTH)))
+    if (entry_point && (smbios_base = ioremap (entry_point, ENTRY_POINT_MAP_LENGTH)))
     {
-        PDEBUG ("ioremap() for entry point failed\n");
-        err = -ENXIO;
-        goto ioremap_for_entry_point_failed;
+        smbios_scan_anchors (smbios_base, ENTRY_POINT_MAP_LENGTH, &anchors);
+
+        if (anchors.sm3 || anchors.sm)
+            PDEBUG ("entry point taken from the firmware at 0x%lx\n", entry_point);
+        else
+        {
+            PDEBUG ("no valid entry point at 0x%lx, scanning the F-segment\n", entry_point);
+            iounmap (smbios_base);
+            smbios_base = 0;
+        }
     }
 
-    PDEBUG ("BIOS base set to 0x%p\n", smbios_base);
+    if (!smbios_base)
+    {
+        /*
+         *  map the SMBIOS memory segment
+         *
+         *  ioremap (kernel) maps a physical address to a virtual address.
+         *  bios start address is e.g. the Bios F-Segment
+         */
+        if (!(smbios_base = ioremap (BIOS_START_ADDRESS, BIOS_MAP_LENGTH)))
+        {
+            PDEBUG ("ioremap() for entry point failed\n");
+            err = -ENXIO;
+            goto ioremap_for_entry_point_failed;
+        }
 
+        PDEBUG ("BIOS base set to 0x%p\n", smbios_base);
 
+#ifdef _DEBUG_
+        smbios_bench_scan ();
+        smbios_bench_struct_length ();
+#endif
+
+        smbios_scan_anchors (smbios_base, BIOS_MAP_LENGTH, &anchors);
+    }
 
 
     /*
@@ -114,12 +164,20 @@ init_module (void)
 
 	/* smbios/dmibios_entry_point points to the beginning of the entry point
      * table. However, they are of different structure (real - proprietary)
+     * The SM-BIOS 3.0 entry point is preferred, it is the only one that
+     * can describe tables above 4 GB or larger than 64 KB. If its table
+     * can't be mapped, the selection is repeated without it.
      */
-    if (!(smbios_entry_point = smbios_find_entry_point (smbios_base)))
+select_entry_point:
+    if (anchors.sm3)
+        smbios3_entry_point = anchors.sm3;
+    else if (anchors.sm)
+        smbios_entry_point = anchors.sm;
+    else
     {
         PDEBUG ("SM-BIOS entry point not found\n");
 
-        if (!(dmibios_entry_point = dmibios_find_entry_point (smbios_base)))
+        if (!(dmibios_entry_point = anchors.dmi))
         {
 	        PDEBUG ("DMI-BIOS entry point not found. Aborting...\n");
 	        err = -ENXIO;
@@ -127,6 +185,12 @@ init_module (void)
         }
     }
 
+    smbios_set_version_string ();
+    PDEBUG ("entry point found at 0x%p, version %s",
+            smbios3_entry_point ? (void *) smbios3_entry_point :
+            smbios_entry_point ? (void *) smbios_entry_point : (void *) dmibios_entry_point,
+            smbios_version_string);
+
     /*
      *  for SM-BIOS:
      *  check if Pointer to DMI structures exist.
@@ -144,18 +208,57 @@ init_module (void)
         }
     }
 
+    /*
+     *  location and length of the SM-BIOS structure table
+     */
+    if (smbios_entry_point)
+    {
+        smbios_table_address = smbios_entry_point->struct_table_address;
+        smbios_table_length = smbios_entry_point->struct_table_length;
+    }
+    if (smbios3_entry_point)
+    {
+        smbios_table_address = smbios3_entry_point->struct_table_address;
+        smbios_table_length = smbios3_entry_point->max_struct_table_size;
+
+        /* a kernel with 32 bit physical addresses can't map a table above 4 GB */
+        if ((unsigned long) smbios_table_address != smbios_table_address)
+        {
+            PDEBUG ("structure table above 4 GB can't be mapped\n");
+
+            if (anchors.sm)
+            {
+                PDEBUG ("taking the SM-BIOS 2.x entry point instead\n");
+                smbios3_entry_point = 0;
+                anchors.sm3 = 0;
+                goto select_entry_point;
+            }
+
+            err = -ENXIO;
+            goto ioremap_for_structures_table_failed;
+        }
+    }
+
     /*
      *  map the SM-BIOS structures physical address range.
 	 *  the 'real' smbios_structures_base contains the starting
 	 *  address, where the instances of dmi structures are located.
      */
-    if (smbios_entry_point)
+    if (!dmibios_entry_point)
     {
         if (!(smbios_structures_base =
-	          ioremap (smbios_entry_point->struct_table_address,
-		        (unsigned long) smbios_entry_point->struct_table_length)))
+	          ioremap ((unsigned long) smbios_table_address, (unsigned long) smbios_table_length)))
 		{
 	        PDEBUG ("ioremap() for structures table failed\n");
+
+            if (smbios3_entry_point && anchors.sm)
+            {
+                PDEBUG ("taking the SM-BIOS 2.x entry point instead\n");
+                smbios3_entry_point = 0;
+                anchors.sm3 = 0;
+                goto select_entry_point;
+            }
+
 	        err = -ENXIO;
 	        goto ioremap_for_structures_table_failed;
         }
@@ -178,6 +281,30 @@ init_module (void)
     }
     PDEBUG ("DMI structures base set to 0x%p\n", smbios_structures_base);
 
+    /*
+     *  copy the tables into normal kernel memory and release the mappings.
+     *  From here on, all pointers refer to the copy.
+     */
+    if (snapshot)
+    {
+        if ((err = smbios_snapshot ()))
+        {
+            PDEBUG ("failed to copy the tables\n");
+            goto snapshot_failed;
+        }
+    }
+
+
+
+    /*
+     *  slab cache of the buffers of the open files
+     */
+    if ((err = smbios_create_caches ()))
+    {
+        PDEBUG ("failed to create the slab caches\n");
+        goto create_caches_failed;
+    }
+
 
 
 	/*
@@ -221,28 +348,60 @@ init_module (void)
     }
     PDEBUG ("/proc/smbios/cooked directory created.\n");
 
+    /* make /proc/smbios/keyvalue directory */
+    if (!(smbios_keyvalue_proc_dir =
+				 create_proc_entry (PROC_DIR_STRING_KEYVALUE, S_IFDIR, smbios_proc_dir)))
+    {
+        err = -ENOMEM;
+		PDEBUG ("failed to create /proc/smbios/keyvalue directory entry\n");
+		goto create_smbios_keyvalue_dir_failed;
+    }
+    PDEBUG ("/proc/smbios/keyvalue directory created.\n");
+
+    /* make /proc/smbios/binary directory */
+    if (!(smbios_binary_proc_dir =
+				 create_proc_entry (PROC_DIR_STRING_BINARY, S_IFDIR, smbios_proc_dir)))
+    {
+        err = -ENOMEM;
+		PDEBUG ("failed to create /proc/smbios/binary directory entry\n");
+		goto create_smbios_binary_dir_failed;
+    }
+    PDEBUG ("/proc/smbios/binary directory created.\n");
+
     /* create version file */
-    if (smbios_entry_point)
+    if (!dmibios_entry_point)
     {
         if ((err = smbios_make_version_entry (smbios_proc_dir)))
 	        goto smbios_make_version_entry_failed;
     }
 
+    /* create stats file */
+    if ((err = smbios_make_stats_entry (smbios_proc_dir)))
+        goto make_smbios_dir_entries_failed;
+
+
+#ifdef _DEBUG_
+   start = get_cycles ();
+#endif
 
    /* make raw files for SM-BIOS */
-   if (smbios_entry_point)
+   if (!dmibios_entry_point)
    {
-        if ((err = smbios_make_dir_entries (smbios_proc_dir, smbios_raw_proc_dir, smbios_cooked_proc_dir)))
+        if ((err = smbios_make_dir_entries (smbios_proc_dir, smbios_raw_proc_dir, smbios_cooked_proc_dir,
+                                            smbios_keyvalue_proc_dir, smbios_binary_proc_dir)))
 	        goto make_smbios_dir_entries_failed;
    }
 	
    /* make files for DMI-BIOS */
    if (dmibios_entry_point)
    {
-        if ((err = dmibios_make_dir_entries (smbios_proc_dir, smbios_raw_proc_dir, smbios_cooked_proc_dir)))
+        if ((err = dmibios_make_dir_entries (smbios_proc_dir, smbios_raw_proc_dir, smbios_cooked_proc_dir,
+                                             smbios_keyvalue_proc_dir, smbios_binary_proc_dir)))
 	        goto make_smbios_dir_entries_failed;
    }
 
+   PDEBUG ("%u structures indexed and files created in %lu cycles\n",
+           smbios_index_count, (unsigned long) (get_cycles () - start));
 	
 
    PDEBUG ("module loaded succesfully\n");
@@ -263,15 +422,29 @@ init_module (void)
  */
 
 make_smbios_dir_entries_failed:
+    /* remove /proc/smbios/binary files */
+    smbios_destroy_dir_entries (smbios_binary_proc_dir);
+    /* remove /proc/smbios/keyvalue files */
+    smbios_destroy_dir_entries (smbios_keyvalue_proc_dir);
     /* remove /proc/smbios/cooked files */
     smbios_destroy_dir_entries (smbios_cooked_proc_dir);
     /* remove /proc/smbios/raw files */
     smbios_destroy_dir_entries (smbios_raw_proc_dir);
     /* remove /proc/smbios files */
     smbios_destroy_dir_entries (smbios_proc_dir);
+    /* free the structure index, no file refers to it any longer */
+    smbios_free_index ();
 	
 smbios_make_version_entry_failed:
 
+    /* remove /proc/smbios/binary directory */
+    remove_proc_entry(PROC_DIR_STRING_BINARY, smbios_proc_dir);
+
+create_smbios_binary_dir_failed:
+    /* remove /proc/smbios/keyvalue directory */
+    remove_proc_entry(PROC_DIR_STRING_KEYVALUE, smbios_proc_dir);
+
+create_smbios_keyvalue_dir_failed:
     /* remove /proc/smbios/cooked directory */
     remove_proc_entry(PROC_DIR_STRING_COOKED, smbios_proc_dir);
 	
@@ -284,15 +457,19 @@ create_smbios_raw_dir_failed:
     remove_proc_entry(PROC_DIR_STRING, &proc_root);
 	
 create_smbios_dir_failed:
-    /* unmap the virtual to physical memory binding */
-    if (smbios_entry_point)
-        iounmap (smbios_structures_base);
+    /* destroy the slab caches, no file is open */
+    smbios_destroy_caches ();
+
+create_caches_failed:
+snapshot_failed:
+    /* unmap the virtual to physical memory binding, resp. free the copy */
+    smbios_release_structures ();
 
 ioremap_for_structures_table_failed:
 check_dmi_failed:
 find_entry_point_failed:
-    /* unmap the virtual to physical memory binding */
-    iounmap (smbios_base);
+    /* unmap the virtual to physical memory binding, resp. free the copy */
+    smbios_release_base ();
 
 ioremap_for_entry_point_failed:
     return err;
@@ -309,26 +486,38 @@ ioremap_for_entry_point_failed:
 void
 cleanup_module (void)
 {
+    /* remove /proc/smbios/binary files */
+    smbios_destroy_dir_entries (smbios_binary_proc_dir);
+    /* remove /proc/smbios/keyvalue files */
+    smbios_destroy_dir_entries (smbios_keyvalue_proc_dir);
     /* remove /proc/smbios/cooked files */
     smbios_destroy_dir_entries (smbios_cooked_proc_dir);
     /* remove /proc/smbios/raw files */
     smbios_destroy_dir_entries (smbios_raw_proc_dir);
     /* remove /proc/smbios files */
     smbios_destroy_dir_entries (smbios_proc_dir);
+    /* free the structure index, no file refers to it any longer */
+    smbios_free_index ();
 	
+    /* remove /proc/smbios/binary directory */
+    remove_proc_entry(PROC_DIR_STRING_BINARY, smbios_proc_dir);
+    /* remove /proc/smbios/keyvalue directory */
+    remove_proc_entry(PROC_DIR_STRING_KEYVALUE, smbios_proc_dir);
     /* remove /proc/smbios/cooked directory */
     remove_proc_entry(PROC_DIR_STRING_COOKED, smbios_proc_dir);
     /* remove /proc/smbios/raw directory */
     remove_proc_entry(PROC_DIR_STRING_RAW, smbios_proc_dir);
     /* remove /proc/smbios directory */
     remove_proc_entry(PROC_DIR_STRING, &proc_root);
+
+    /* destroy the slab caches, no file is open */
+    smbios_destroy_caches ();
 	
-    /* unmap the virtual to physical memory binding */
-    if (smbios_entry_point)
-        iounmap (smbios_structures_base);
+    /* unmap the virtual to physical memory binding, resp. free the copy */
+    smbios_release_structures ();
 
-    /* unmap the virtual to physical memory binding */
-    iounmap (smbios_base);
+    /* unmap the virtual to physical memory binding, resp. free the copy */
+    smbios_release_base ();
 
     PDEBUG ("module unloaded\n");
 }
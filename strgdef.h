@@ -54,6 +54,22 @@
 /** name of the directory in the proc file system that holds the cooked (ascii)
  *   types */
 #define PROC_DIR_STRING_COOKED			    "cooked"
+/** name of the directory in the proc file system that holds the cooked types
+ *   as key=value lines */
+#define PROC_DIR_STRING_KEYVALUE		    "keyvalue"
+/** name of the directory in the proc file system that holds the types in the
+ *   binary format */
+#define PROC_DIR_STRING_BINARY			    "binary"
+/** name of the file that holds the cooked text, resp. the binary format, of all structures */
+#define PROC_FILE_STRING_ALL			    "all"
+/** name of the file in the raw directory that holds the whole structure table */
+#define PROC_FILE_STRING_TABLE			    "table"
+/** name of the file in the raw directory that holds the entry point structure */
+#define PROC_FILE_STRING_ENTRY_POINT	    "entry_point"
+/** name of the file in the raw directory that can be mapped by applications */
+#define PROC_FILE_STRING_MAP			    "map"
+/** name of the file that holds the allocation counters */
+#define PROC_FILE_STRING_STATS			    "stats"
 
 
 
@@ -225,6 +241,10 @@
 #define TYPE                            "Type"
 #define LENGTH                          "Length"
 #define HANDLE                          "Handle"
+/* the header in the key=value files, apart from the fields named "Type" */
+#define KV_TYPE                         "Structure Type"
+#define KV_LENGTH                       "Structure Length"
+#define KV_HANDLE                       "Structure Handle"
 
 /*
  * Type 0 - Bios
@@ -856,6 +876,7 @@
 #define TYPE9_LENGTH_SHORT              "Short Length"
 #define TYPE9_LENGTH_LONG               "Long Length"
 
+#define TYPE9_ID                        "Slot ID"
 #define TYPE9_ID_MCA_SLOT_NR            "MCA Slot Number"
 #define TYPE9_ID_EISA_SLOT_NR           "EISA Slot Number"
 #define TYPE9_ID_PCI_SLOT_NR            "Slot Number"
@@ -1141,6 +1162,13 @@
 #define SMB_FALSE                       "False"
 #define NOT_SUPPORTED                   "This structure is not supported so far."
 
+/* labels of the stats file */
+#define STATS_OPENS                     "Files opened"
+#define STATS_BUFFER_ALLOCS             "File buffers allocated"
+#define STATS_BUFFER_FREES              "File buffers freed"
+#define STATS_RENDERS                   "Outputs rendered"
+#define STATS_CACHE_HITS                "Outputs taken from the cache"
+
 #define SEP1                            ":"
 #define SEP2                            ">"
 
@@ -0,0 +1,82 @@
+# strpool.awk - generates strpool.h, the string pool of the decoding tables
+#
+# usage: awk -f strpool.awk cooking.c strgdef.h > strpool.h
+#
+# every STR_<name> the first file uses becomes the offset of the string
+# <name> of strgdef.h in smbios_strings[]. equal strings are put into
+# the pool once. offset 0 is an empty string, it means "no name".
+
+
+BEGIN {
+    size = 1
+    errors = 0
+}
+
+# the first file: collect the names the tables use
+FNR == NR {
+    line = $0
+    while (match (line, /(^|[^A-Za-z0-9_])STR_[A-Za-z0-9_]+/))
+    {
+        name = substr (line, RSTART, RLENGTH)
+        sub (/^.*STR_/, "", name)
+        used[name] = 1
+        line = substr (line, RSTART + RLENGTH)
+    }
+    next
+}
+
+# the second file: the string definitions
+/^#define[ \t]+[A-Za-z0-9_]+[ \t]+"/ {
+    name = $2
+    if (!(name in used) || (name in offset))
+        next
+
+    value = $0
+    sub (/^#define[ \t]+[A-Za-z0-9_]+[ \t]+"/, "", value)
+    sub (/".*$/, "", value)
+
+    if (!(value in pooled))
+    {
+        pooled[value] = size
+        pool[++no_of_strings] = value
+        size += length (value) + 1
+    }
+    offset[name] = pooled[value]
+    names[++no_of_names] = name
+}
+
+END {
+    for (name in used)
+    {
+        if (!(name in offset))
+        {
+            printf ("strpool.awk: STR_%s is not a string of strgdef.h\n", name) > "/dev/stderr"
+            errors++
+        }
+    }
+    if (size > 65536)
+    {
+        printf ("strpool.awk: the pool has %d bytes, offsets are 16 bit\n", size) > "/dev/stderr"
+        errors++
+    }
+    if (errors)
+        exit 1
+
+    print "/* strpool.h - generated from strgdef.h by strpool.awk, do not edit */"
+    print ""
+    print "#ifndef __STRPOOL_H__"
+    print "#define __STRPOOL_H__"
+    print ""
+    printf ("/** %d strings of the decoding tables, %d bytes */\n", no_of_strings, size)
+    print "static const char smbios_strings[] ="
+    print "    \"\\0\""
+    for (i = 1; i <= no_of_strings; i++)
+        printf ("    \"%s\\0\"\n", pool[i])
+    print "    ;"
+    print ""
+    print "/** offsets of the strings in smbios_strings[] */"
+    for (i = 1; i <= no_of_names; i++)
+        printf ("#define STR_%-40s %d\n", names[i], offset[names[i]])
+    print ""
+    print "#endif /* __STRPOOL_H__ */"
+}